@@ -24,17 +24,27 @@
 
 #include "AppDelegate.h"
 #include "controllers/GameController.h"
+#include "controllers/LoadingController.h"
+#include "services/RenderOnDemandService.h"
+#include "services/TraceService.h"
+#include "views/CardAtlas.h"
 #include "cocos2d.h"
 
 USING_NS_CC;
 
 AppDelegate::AppDelegate()
 : _gameController(nullptr)
+, _loadingController(nullptr)
 {
 }
 
 AppDelegate::~AppDelegate()
 {
+    if (_loadingController != nullptr)
+    {
+        delete _loadingController;
+        _loadingController = nullptr;
+    }
     if (_gameController != nullptr)
     {
         delete _gameController;
@@ -61,10 +71,40 @@ bool AppDelegate::applicationDidFinishLaunching()
 
     director->setDisplayStats(false);
     director->setAnimationInterval(1.0 / 60);
+    
+    // 帧阶段追踪；调试包开启远程控制台，可用trace dump导出Chrome Trace JSON
+    TraceService::install();
+#if COCOS2D_DEBUG > 0
+    director->getConsole()->listenOnTCP(5678);
+#endif
+    
+    // 画面静止时停止出帧，输入或动画时恢复；Android的GLSurfaceView每帧都会交换缓冲区，跳过绘制会闪烁，不开启
+#if CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID
+    RenderOnDemandService::setEnabled(true);
+#endif
 
-    // 创建游戏控制器并启动游戏
-    _gameController = new GameController();
-    Scene* scene = _gameController->startGame(1);  // 启动关卡1
+    // 先显示加载场景：卡牌纹理在加载线程解码，完成后合成卡牌图集，再创建游戏控制器并启动关卡1，有存档时继续上次的牌局
+    _loadingController = new LoadingController();
+    Scene* scene = _loadingController->startLoading([this]() -> Scene* {
+        _gameController = new GameController();
+        Scene* gameScene = _gameController->startGame(1);
+        if (gameScene != nullptr)
+        {
+            _gameController->resumeSavedGame();
+        }
+        return gameScene;
+    });
+    if (scene == nullptr)
+    {
+        // 加载场景创建失败时同步加载（图集失败时按原方式逐个精灵显示）
+        CardAtlas::getInstance()->build();
+        _gameController = new GameController();
+        scene = _gameController->startGame(1);
+        if (scene != nullptr)
+        {
+            _gameController->resumeSavedGame();
+        }
+    }
     
     if (scene != nullptr)
     {
@@ -81,6 +121,12 @@ bool AppDelegate::applicationDidFinishLaunching()
 void AppDelegate::applicationDidEnterBackground()
 {
     Director::getInstance()->stopAnimation();
+    
+    // 进入后台后进程可能被系统结束，此时存档，下次启动时继续
+    if (_gameController != nullptr)
+    {
+        _gameController->saveGame();
+    }
 }
 
 void AppDelegate::applicationWillEnterForeground()
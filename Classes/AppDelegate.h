@@ -34,6 +34,7 @@ Private inheritance here hides part of interface from Director.
 */
 // 前向声明
 class GameController;
+class LoadingController;
 
 class  AppDelegate : private cocos2d::Application
 {
@@ -64,6 +65,7 @@ public:
 
 private:
     GameController* _gameController;  // 游戏控制器指针，确保生命周期
+    LoadingController* _loadingController;  // 加载控制器指针，加载完成后创建游戏控制器
 };
 
 #endif // _APP_DELEGATE_H_
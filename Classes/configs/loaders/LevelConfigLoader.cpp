@@ -23,14 +23,40 @@
  ****************************************************************************/
 
 #include "LevelConfigLoader.h"
+#include "LevelPack.h"
 
 LevelConfig* LevelConfigLoader::loadLevelConfig(int levelId)
 {
-    // TODO: 从配置文件加载
-    // 目前返回默认配置
+    LevelConfig* config = new LevelConfig();
+    if (getLevelPack()->fillLevelConfig(levelId, config))
+    {
+        return config;
+    }
+    delete config;
+    
+    // 关卡包中没有该关卡，返回默认配置
     return createDefaultLevelConfig();
 }
 
+bool LevelConfigLoader::openLevelPack(const std::string& filename)
+{
+    return getSharedLevelPack()->open(filename);
+}
+
+const LevelPack* LevelConfigLoader::getLevelPack()
+{
+    return getSharedLevelPack();
+}
+
+LevelPack* LevelConfigLoader::getSharedLevelPack()
+{
+    // 局部静态变量的初始化是线程安全的，默认关卡包只打开一次
+    static LevelPack levelPack;
+    static bool defaultPackOpened = levelPack.open(LevelPackFormat::DEFAULT_FILE);
+    (void)defaultPackOpened;
+    return &levelPack;
+}
+
 LevelConfig* LevelConfigLoader::createDefaultLevelConfig()
 {
     LevelConfig* config = new LevelConfig();
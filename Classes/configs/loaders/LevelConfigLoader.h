@@ -25,12 +25,19 @@
 #ifndef __LEVEL_CONFIG_LOADER_H__
 #define __LEVEL_CONFIG_LOADER_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
 #include "../models/LevelConfig.h"
+#include <string>
+
+// 前向声明
+class LevelPack;
 
 /**
  * @brief 关卡配置加载器
  * 负责从配置文件或数据源加载关卡配置
+ * 关卡来自预编译关卡包（默认LevelPackFormat::DEFAULT_FILE，首次加载时打开），包中没有的关卡使用默认配置
  */
 class LevelConfigLoader
 {
@@ -42,6 +49,18 @@ public:
      */
     static LevelConfig* loadLevelConfig(int levelId);
     
+    /**
+     * @brief 改用指定的关卡包（关闭当前关卡包，不可与loadLevelConfig并发调用）
+     * @param filename 关卡包文件名
+     * @return 是否打开成功，失败时之后的加载都使用默认配置
+     */
+    static bool openLevelPack(const std::string& filename);
+    
+    /**
+     * @brief 获取当前关卡包（首次调用时打开默认关卡包）
+     */
+    static const LevelPack* getLevelPack();
+    
     /**
      * @brief 创建默认关卡配置（用于测试）
      * @return 关卡配置对象
@@ -51,6 +70,8 @@ public:
 private:
     LevelConfigLoader() {}
     virtual ~LevelConfigLoader() {}
+    
+    static LevelPack* getSharedLevelPack();
 };
 
 #endif // __LEVEL_CONFIG_LOADER_H__
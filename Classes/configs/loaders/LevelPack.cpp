@@ -0,0 +1,280 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "LevelPack.h"
+#include "../models/LevelConfig.h"
+#include <cstdio>
+#include <cstring>
+#ifndef GAME_HEADLESS
+#include "platform/CCFileUtils.h"
+#endif
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+LevelPack::LevelPack()
+: _data(nullptr)
+, _size(0)
+, _header(nullptr)
+, _index(nullptr)
+, _mapping(nullptr)
+, _mappingHandle(nullptr)
+{
+}
+
+LevelPack::~LevelPack()
+{
+    close();
+}
+
+bool LevelPack::open(const std::string& filename)
+{
+    close();
+    
+#ifdef GAME_HEADLESS
+    std::string path = filename;
+#else
+    std::string path = cocos2d::FileUtils::getInstance()->fullPathForFilename(filename);
+    if (path.empty())
+    {
+        return false;
+    }
+#endif
+    
+    if (!mapFile(path))
+    {
+#ifdef GAME_HEADLESS
+        return false;
+#else
+        // APK内的资源等无法映射的文件，整体读入
+        if (cocos2d::FileUtils::getInstance()->getContents(path, &_buffer) != cocos2d::FileUtils::Status::OK)
+        {
+            return false;
+        }
+        _data = _buffer.data();
+        _size = _buffer.size();
+#endif
+    }
+    
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void LevelPack::close()
+{
+    if (_mapping != nullptr)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(_mapping);
+        CloseHandle((HANDLE)_mappingHandle);
+#else
+        munmap(_mapping, _size);
+#endif
+    }
+    _mapping = nullptr;
+    _mappingHandle = nullptr;
+    std::vector<unsigned char>().swap(_buffer);
+    _data = nullptr;
+    _size = 0;
+    _header = nullptr;
+    _index = nullptr;
+}
+
+bool LevelPack::mapFile(const std::string& path)
+{
+#if defined(_WIN32)
+    int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (length <= 0)
+    {
+        return false;
+    }
+    std::vector<wchar_t> widePath(length);
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), length);
+    
+    HANDLE file = CreateFileW(widePath.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    // 映射建立后即可关闭文件句柄
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    _mapping = view;
+    _mappingHandle = mapping;
+    _size = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat fileStat;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // 映射建立后即可关闭文件描述符
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+    _mapping = view;
+    _size = (size_t)fileStat.st_size;
+#endif
+    _data = (const unsigned char*)_mapping;
+    return true;
+}
+
+bool LevelPack::validate()
+{
+    using namespace LevelPackFormat;
+    
+    if (_data == nullptr || _size < sizeof(Header))
+    {
+        return false;
+    }
+    
+    const Header* header = (const Header*)_data;
+    if (header->magic != MAGIC || header->version != VERSION || header->headerSize != sizeof(Header)
+        || header->fileSize != _size || header->levelCount > header->slotCount
+        || header->indexOffset % 4 != 0 || header->indexOffset < sizeof(Header))
+    {
+        return false;
+    }
+    
+    // 索引表不越界（用64位计算避免溢出）
+    uint64_t indexEnd = (uint64_t)header->indexOffset + (uint64_t)header->slotCount * sizeof(IndexEntry);
+    if (indexEnd > _size)
+    {
+        return false;
+    }
+    
+    _header = header;
+    _index = (const IndexEntry*)(_data + header->indexOffset);
+    return true;
+}
+
+const LevelPackFormat::Record* LevelPack::getRecord(int levelId) const
+{
+    using namespace LevelPackFormat;
+    
+    if (_header == nullptr)
+    {
+        return nullptr;
+    }
+    
+    int64_t slot = (int64_t)levelId - _header->firstLevelId;
+    if (slot < 0 || slot >= (int64_t)_header->slotCount)
+    {
+        return nullptr;
+    }
+    
+    const IndexEntry& entry = _index[slot];
+    if (entry.offset == 0 || entry.offset % 4 != 0 || entry.size < sizeof(Record)
+        || (uint64_t)entry.offset + entry.size > _size)
+    {
+        return nullptr;
+    }
+    
+    const Record* record = (const Record*)(_data + entry.offset);
+    if (record->levelId != levelId
+        || record->layoutType > LAYOUT_TYPE_CUSTOM
+        || getRecordSize(record->nameLength, record->playFieldCount, record->stackCount, record->coverCount,
+                         getPositionCount(*record)) != entry.size)
+    {
+        return nullptr;
+    }
+    return record;
+}
+
+bool LevelPack::fillLevelConfig(int levelId, LevelConfig* levelConfig) const
+{
+    const LevelPackFormat::Record* record = getRecord(levelId);
+    if (record == nullptr || levelConfig == nullptr)
+    {
+        return false;
+    }
+    
+    const char* name = (const char*)(record + 1);
+    const int* playFieldCards = (const int*)(name + LevelPackFormat::align4(record->nameLength));
+    const int* stackCards = playFieldCards + record->playFieldCount;
+    const LevelPackFormat::CoverEntry* covers = (const LevelPackFormat::CoverEntry*)(stackCards + record->stackCount);
+    const LevelPackFormat::LayoutEntry* layout = (const LevelPackFormat::LayoutEntry*)(covers + record->coverCount);
+    const LevelPackFormat::PositionEntry* positions = (const LevelPackFormat::PositionEntry*)(layout + 1);
+    
+    levelConfig->setLevelId(levelId);
+    levelConfig->setLevelName(std::string(name, record->nameLength));
+    levelConfig->setPlayFieldCards(playFieldCards, record->playFieldCount);
+    levelConfig->setStackCards(stackCards, record->stackCount);
+    
+    std::vector<PlayFieldCoverConfig> playFieldCovers(record->coverCount);
+    for (uint16_t i = 0; i < record->coverCount; ++i)
+    {
+        playFieldCovers[i].coverIndex = covers[i].coverIndex;
+        playFieldCovers[i].coveredIndex = covers[i].coveredIndex;
+    }
+    levelConfig->setPlayFieldCovers(playFieldCovers);
+    
+    PlayFieldLayoutConfig playFieldLayout;
+    playFieldLayout.type = (PlayFieldLayoutType)record->layoutType;
+    playFieldLayout.columns = record->layoutColumns;
+    playFieldLayout.spacingX = layout->spacingX;
+    playFieldLayout.spacingY = layout->spacingY;
+    uint32_t positionCount = LevelPackFormat::getPositionCount(*record);
+    playFieldLayout.positions.resize(positionCount);
+    for (uint32_t i = 0; i < positionCount; ++i)
+    {
+        playFieldLayout.positions[i].x = positions[i].x;
+        playFieldLayout.positions[i].y = positions[i].y;
+    }
+    levelConfig->setPlayFieldLayout(playFieldLayout);
+    return true;
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __LEVEL_PACK_H__
+#define __LEVEL_PACK_H__
+
+#include "LevelPackFormat.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 前向声明
+class LevelConfig;
+
+/**
+ * @brief 预编译关卡包
+ * 打开时只映射文件并校验文件头和索引表范围，不解析任何关卡
+ * 按ID取关卡为一次索引查表，启动耗时和常驻内存与关卡数量无关（页面由系统按需调入）
+ * 无法映射的文件（如Android APK内的资源）退化为FileUtils整体读入
+ */
+class LevelPack
+{
+public:
+    LevelPack();
+    virtual ~LevelPack();
+    
+    /**
+     * @brief 打开关卡包（已打开时先关闭）
+     * @param filename 文件名，经FileUtils解析搜索路径（GAME_HEADLESS下为文件路径）
+     * @return 文件存在且格式有效时返回true
+     */
+    bool open(const std::string& filename);
+    
+    /**
+     * @brief 关闭关卡包，解除映射
+     */
+    void close();
+    
+    /**
+     * @brief 是否已打开
+     */
+    bool isOpen() const { return _header != nullptr; }
+    
+    /**
+     * @brief 关卡数量
+     */
+    int getLevelCount() const { return isOpen() ? (int)_header->levelCount : 0; }
+    
+    /**
+     * @brief 是否包含该关卡
+     */
+    bool hasLevel(int levelId) const { return getRecord(levelId) != nullptr; }
+    
+    /**
+     * @brief 用关卡包中的数据填充关卡配置（O(1)查表，直接从映射内存复制卡牌ID）
+     * @param levelId 关卡ID
+     * @param levelConfig 输出
+     * @return 关卡不存在时返回false，levelConfig不变
+     */
+    bool fillLevelConfig(int levelId, LevelConfig* levelConfig) const;
+
+private:
+    /**
+     * @brief 查找关卡记录，并校验记录不越界
+     */
+    const LevelPackFormat::Record* getRecord(int levelId) const;
+    
+    /**
+     * @brief 校验文件头和索引表，成功后设置_header和_index
+     */
+    bool validate();
+    
+    /**
+     * @brief 映射文件，失败时返回false
+     */
+    bool mapFile(const std::string& path);
+    
+    const unsigned char* _data;                 // 文件内容（映射内存或_buffer）
+    size_t _size;                               // 文件字节数
+    const LevelPackFormat::Header* _header;     // 文件头，未打开时为nullptr
+    const LevelPackFormat::IndexEntry* _index;  // 索引表
+    std::vector<unsigned char> _buffer;         // 无法映射时的整体读入缓冲
+    void* _mapping;                             // 映射起始地址，未映射时为nullptr
+    void* _mappingHandle;                       // Windows文件映射句柄
+};
+
+#endif // __LEVEL_PACK_H__
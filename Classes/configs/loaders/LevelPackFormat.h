@@ -0,0 +1,127 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __LEVEL_PACK_FORMAT_H__
+#define __LEVEL_PACK_FORMAT_H__
+
+#include <cstdint>
+
+/**
+ * @brief 关卡包二进制格式（小端，所有偏移4字节对齐），由tools/levelpack离线生成，LevelPack映射读取
+ * 布局：文件头 | 索引表（按levelId - firstLevelId下标，offset为0表示该ID没有关卡）| 关卡记录
+ * 关卡记录：LevelPackRecord | 名称（UTF-8，补齐到4字节）| 主牌区卡牌ID | 备用牌堆卡牌ID | 主牌区遮挡关系
+ *          | 布局间距 | 自定义布局坐标（仅CUSTOM布局，每张主牌区卡牌一项）
+ */
+namespace LevelPackFormat
+{
+    static const uint32_t MAGIC = 0x4B50564C;  // "LVPK"
+    static const uint32_t VERSION = 3;         // 2: 增加主牌区遮挡关系；3: 增加主牌区布局
+    static const char* const DEFAULT_FILE = "levels/levels.pack";
+    static const uint16_t LAYOUT_TYPE_CUSTOM = 2;  // 与PlayFieldLayoutType::CUSTOM一致
+    
+    struct Header
+    {
+        uint32_t magic;             // MAGIC
+        uint32_t version;           // VERSION
+        uint32_t headerSize;        // sizeof(Header)
+        uint32_t fileSize;          // 文件总字节数
+        int32_t firstLevelId;       // 索引表第0项对应的关卡ID
+        uint32_t slotCount;         // 索引表项数（最大关卡ID - firstLevelId + 1）
+        uint32_t levelCount;        // 实际关卡数量
+        uint32_t indexOffset;       // 索引表偏移
+    };
+    
+    struct IndexEntry
+    {
+        uint32_t offset;            // 关卡记录偏移，0表示没有该关卡
+        uint32_t size;              // 关卡记录字节数
+    };
+    
+    struct Record
+    {
+        int32_t levelId;
+        uint16_t nameLength;        // 名称字节数（不含补齐）
+        uint16_t playFieldCount;    // 主牌区卡牌数量
+        uint16_t stackCount;        // 备用牌堆卡牌数量
+        uint16_t coverCount;        // 主牌区遮挡关系数量
+        uint16_t layoutType;        // PlayFieldLayoutType
+        uint16_t layoutColumns;     // 网格布局的列数
+    };
+    
+    struct CoverEntry
+    {
+        uint16_t coverIndex;        // 上层卡牌在主牌区中的位置
+        uint16_t coveredIndex;      // 被遮挡卡牌在主牌区中的位置
+    };
+    
+    struct LayoutEntry
+    {
+        float spacingX;             // 同一行相邻卡牌中心的横向距离
+        float spacingY;             // 相邻两行中心的纵向距离
+    };
+    
+    struct PositionEntry
+    {
+        float x;                    // 卡牌中心相对主牌区中心的坐标
+        float y;
+    };
+    
+    static_assert(sizeof(Header) == 32, "level pack header layout changed");
+    static_assert(sizeof(IndexEntry) == 8, "level pack index layout changed");
+    static_assert(sizeof(Record) == 16, "level pack record layout changed");
+    static_assert(sizeof(CoverEntry) == 4, "level pack cover layout changed");
+    static_assert(sizeof(LayoutEntry) == 8, "level pack layout entry changed");
+    static_assert(sizeof(PositionEntry) == 8, "level pack position layout changed");
+    static_assert(sizeof(int) == sizeof(int32_t), "card ids are stored as int32");
+    
+    /**
+     * @brief 向上补齐到4字节
+     */
+    inline uint32_t align4(uint32_t size)
+    {
+        return (size + 3u) & ~3u;
+    }
+    
+    /**
+     * @brief 自定义布局坐标数量（CUSTOM布局为主牌区卡牌数，其他布局为0）
+     */
+    inline uint32_t getPositionCount(const Record& record)
+    {
+        return record.layoutType == LAYOUT_TYPE_CUSTOM ? record.playFieldCount : 0;
+    }
+    
+    /**
+     * @brief 关卡记录总字节数
+     */
+    inline uint32_t getRecordSize(uint32_t nameLength, uint32_t playFieldCount, uint32_t stackCount, uint32_t coverCount,
+                                  uint32_t positionCount)
+    {
+        return (uint32_t)sizeof(Record) + align4(nameLength) + (playFieldCount + stackCount) * (uint32_t)sizeof(int32_t)
+            + coverCount * (uint32_t)sizeof(CoverEntry) + (uint32_t)sizeof(LayoutEntry)
+            + positionCount * (uint32_t)sizeof(PositionEntry);
+    }
+}
+
+#endif // __LEVEL_PACK_FORMAT_H__
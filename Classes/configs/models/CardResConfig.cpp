@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include "CardResConfig.h"
+#include <cstdio>
 
 CardResConfig* CardResConfig::_instance = nullptr;
 
@@ -46,58 +47,105 @@ void CardResConfig::destroyInstance()
 
 CardResConfig::CardResConfig()
 {
+    _paths[RES_BACKGROUND] = "res/card_general.png";
+    _paths[RES_BACK] = "res/card_back.png";
+    
+    static const char* const SUIT_NAMES[CST_NUM_CARD_SUIT_TYPES] = { "club", "diamond", "heart", "spade" };
+    for (int suit = 0; suit < CST_NUM_CARD_SUIT_TYPES; ++suit)
+    {
+        _paths[RES_SUIT_BEGIN + suit] = std::string("res/suits/") + SUIT_NAMES[suit] + ".png";
+    }
+    
+    // 路径只在这里拼接一次，之后的查询直接返回引用
+    char buffer[256];
+    for (int color = 0; color < 2; ++color)
+    {
+        const char* colorName = (color == 1) ? "red" : "black";
+        for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face)
+        {
+            std::string faceStr = faceToString((CardFaceType)face);
+            snprintf(buffer, sizeof(buffer), "res/number/big_%s_%s.png", colorName, faceStr.c_str());
+            _paths[getNumberResId(RES_BIG_NUMBER_BEGIN, (CardFaceType)face, color == 1)] = buffer;
+            snprintf(buffer, sizeof(buffer), "res/number/small_%s_%s.png", colorName, faceStr.c_str());
+            _paths[getNumberResId(RES_SMALL_NUMBER_BEGIN, (CardFaceType)face, color == 1)] = buffer;
+        }
+    }
+    
+    _preloadManifest.assign(_paths, _paths + RES_COUNT);
+    
+#ifndef GAME_HEADLESS
+    for (int i = 0; i < RES_COUNT; ++i)
+    {
+        _textures[i] = nullptr;
+        _textureResolved[i] = false;
+    }
+#endif
 }
 
 CardResConfig::~CardResConfig()
 {
+#ifndef GAME_HEADLESS
+    for (int i = 0; i < RES_COUNT; ++i)
+    {
+        CC_SAFE_RELEASE_NULL(_textures[i]);
+    }
+#endif
 }
 
-std::string CardResConfig::getCardBackgroundPath()
+int CardResConfig::getSuitResId(CardSuitType suit)
 {
-    return "res/card_general.png";
+    if (suit < 0 || suit >= CST_NUM_CARD_SUIT_TYPES)
+    {
+        return -1;
+    }
+    return RES_SUIT_BEGIN + suit;
 }
 
-std::string CardResConfig::getSuitImagePath(CardSuitType suit)
+int CardResConfig::getNumberResId(int begin, CardFaceType face, bool isRed)
 {
-    switch (suit)
+    if (face < 0 || face >= CFT_NUM_CARD_FACE_TYPES)
     {
-        case CST_CLUBS:
-            return "res/suits/club.png";
-        case CST_DIAMONDS:
-            return "res/suits/diamond.png";
-        case CST_HEARTS:
-            return "res/suits/heart.png";
-        case CST_SPADES:
-            return "res/suits/spade.png";
-        default:
-            return "";
+        return -1;
     }
+    return begin + (isRed ? CFT_NUM_CARD_FACE_TYPES : 0) + face;
 }
 
-std::string CardResConfig::getBigNumberImagePath(CardFaceType face, bool isRed)
+const std::string& CardResConfig::getPath(int resId) const
 {
-    std::string color = isRed ? "red" : "black";
-    std::string faceStr = faceToString(face);
-    char buffer[256];
-    snprintf(buffer, sizeof(buffer), "res/number/big_%s_%s.png", color.c_str(), faceStr.c_str());
-    return std::string(buffer);
+    static const std::string EMPTY_PATH;
+    if (resId < 0 || resId >= RES_COUNT)
+    {
+        return EMPTY_PATH;
+    }
+    return _paths[resId];
 }
 
-std::string CardResConfig::getSmallNumberImagePath(CardFaceType face, bool isRed)
+const std::string& CardResConfig::getCardBackgroundPath() const
 {
-    std::string color = isRed ? "red" : "black";
-    std::string faceStr = faceToString(face);
-    char buffer[256];
-    snprintf(buffer, sizeof(buffer), "res/number/small_%s_%s.png", color.c_str(), faceStr.c_str());
-    return std::string(buffer);
+    return _paths[RES_BACKGROUND];
+}
+
+const std::string& CardResConfig::getSuitImagePath(CardSuitType suit) const
+{
+    return getPath(getSuitResId(suit));
+}
+
+const std::string& CardResConfig::getBigNumberImagePath(CardFaceType face, bool isRed) const
+{
+    return getPath(getNumberResId(RES_BIG_NUMBER_BEGIN, face, isRed));
+}
+
+const std::string& CardResConfig::getSmallNumberImagePath(CardFaceType face, bool isRed) const
+{
+    return getPath(getNumberResId(RES_SMALL_NUMBER_BEGIN, face, isRed));
 }
 
-bool CardResConfig::isRedSuit(CardSuitType suit)
+bool CardResConfig::isRedSuit(CardSuitType suit) const
 {
     return suit == CST_HEARTS || suit == CST_DIAMONDS;
 }
 
-std::string CardResConfig::faceToString(CardFaceType face)
+std::string CardResConfig::faceToString(CardFaceType face) const
 {
     switch (face)
     {
@@ -132,8 +180,62 @@ std::string CardResConfig::faceToString(CardFaceType face)
     }
 }
 
-std::string CardResConfig::getCardBackImagePath()
+const std::string& CardResConfig::getCardBackImagePath() const
 {
-    return "res/card_back.png";
+    return _paths[RES_BACK];
 }
 
+#ifndef GAME_HEADLESS
+cocos2d::Texture2D* CardResConfig::getCardBackgroundTexture()
+{
+    return getTexture(RES_BACKGROUND);
+}
+
+cocos2d::Texture2D* CardResConfig::getSuitTexture(CardSuitType suit)
+{
+    return getTexture(getSuitResId(suit));
+}
+
+cocos2d::Texture2D* CardResConfig::getBigNumberTexture(CardFaceType face, bool isRed)
+{
+    return getTexture(getNumberResId(RES_BIG_NUMBER_BEGIN, face, isRed));
+}
+
+cocos2d::Texture2D* CardResConfig::getSmallNumberTexture(CardFaceType face, bool isRed)
+{
+    return getTexture(getNumberResId(RES_SMALL_NUMBER_BEGIN, face, isRed));
+}
+
+cocos2d::Texture2D* CardResConfig::getCardBackTexture()
+{
+    return getTexture(RES_BACK);
+}
+
+void CardResConfig::bindTextures()
+{
+    for (int i = 0; i < RES_COUNT; ++i)
+    {
+        getTexture(i);
+    }
+}
+
+cocos2d::Texture2D* CardResConfig::getTexture(int resId)
+{
+    if (resId < 0 || resId >= RES_COUNT)
+    {
+        return nullptr;
+    }
+    
+    if (!_textureResolved[resId])
+    {
+        // 已预加载时只是缓存查找；牌背等可选资源不存在时不报错
+        _textureResolved[resId] = true;
+        if (cocos2d::FileUtils::getInstance()->isFileExist(_paths[resId]))
+        {
+            _textures[resId] = cocos2d::Director::getInstance()->getTextureCache()->addImage(_paths[resId]);
+            CC_SAFE_RETAIN(_textures[resId]);
+        }
+    }
+    return _textures[resId];
+}
+#endif
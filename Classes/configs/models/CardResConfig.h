@@ -25,7 +25,11 @@
 #ifndef __CARD_RES_CONFIG_H__
 #define __CARD_RES_CONFIG_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
+#include <string>
+#include <vector>
 
 /**
  * @brief 花色类型枚举
@@ -65,6 +69,7 @@ enum CardFaceType
 /**
  * @brief 卡牌UI资源配置类
  * 负责管理卡牌的图片资源路径等配置信息
+ * 所有路径在构造时生成一次，查询时直接返回引用；纹理句柄首次使用（或预加载完成后bindTextures）时解析并持有引用
  */
 class CardResConfig
 {
@@ -83,56 +88,110 @@ public:
      * @brief 获取卡牌背景图片资源路径
      * @return 资源路径
      */
-    std::string getCardBackgroundPath();
+    const std::string& getCardBackgroundPath() const;
     
     /**
      * @brief 获取花色图标资源路径
      * @param suit 花色
-     * @return 资源路径
+     * @return 资源路径（花色无效时为空字符串）
      */
-    std::string getSuitImagePath(CardSuitType suit);
+    const std::string& getSuitImagePath(CardSuitType suit) const;
     
     /**
      * @brief 获取大数字图标资源路径
      * @param face 点数
      * @param isRed 是否为红色（红桃、方块为红色，梅花、黑桃为黑色）
-     * @return 资源路径
+     * @return 资源路径（点数无效时为空字符串）
      */
-    std::string getBigNumberImagePath(CardFaceType face, bool isRed);
+    const std::string& getBigNumberImagePath(CardFaceType face, bool isRed) const;
     
     /**
      * @brief 获取小数字图标资源路径
      * @param face 点数
      * @param isRed 是否为红色（红桃、方块为红色，梅花、黑桃为黑色）
-     * @return 资源路径
+     * @return 资源路径（点数无效时为空字符串）
      */
-    std::string getSmallNumberImagePath(CardFaceType face, bool isRed);
+    const std::string& getSmallNumberImagePath(CardFaceType face, bool isRed) const;
     
     /**
      * @brief 判断花色是否为红色
      * @param suit 花色
      * @return true表示红色，false表示黑色
      */
-    bool isRedSuit(CardSuitType suit);
+    bool isRedSuit(CardSuitType suit) const;
     
     /**
      * @brief 将点数转换为字符串（用于文件名）
      * @param face 点数
      * @return 字符串（如"A", "2", "3", ..., "K"）
      */
-    std::string faceToString(CardFaceType face);
+    std::string faceToString(CardFaceType face) const;
     
     /**
      * @brief 获取卡牌背面图片资源路径
      * @return 资源路径
      */
-    std::string getCardBackImagePath();
+    const std::string& getCardBackImagePath() const;
+    
+    /**
+     * @brief 获取需要预加载的全部卡牌图片路径（不重复）
+     */
+    const std::vector<std::string>& getPreloadManifest() const { return _preloadManifest; }
+    
+#ifndef GAME_HEADLESS
+    /**
+     * @brief 获取卡牌背景、花色、大数字、小数字、牌背纹理（与对应的路径一一对应）
+     * 未预加载的纹理在首次调用时同步加载，之后直接返回同一个句柄；加载失败返回nullptr且不再重试
+     */
+    cocos2d::Texture2D* getCardBackgroundTexture();
+    cocos2d::Texture2D* getSuitTexture(CardSuitType suit);
+    cocos2d::Texture2D* getBigNumberTexture(CardFaceType face, bool isRed);
+    cocos2d::Texture2D* getSmallNumberTexture(CardFaceType face, bool isRed);
+    cocos2d::Texture2D* getCardBackTexture();
+    
+    /**
+     * @brief 预加载完成后从纹理缓存解析全部纹理句柄（已在缓存中，不再解码）
+     */
+    void bindTextures();
+#endif
 
 private:
     CardResConfig();
     virtual ~CardResConfig();
     
+    /**
+     * @brief 资源下标：背景 | 牌背 | 花色 | 大数字（黑、红各13个）| 小数字（黑、红各13个）
+     */
+    enum
+    {
+        RES_BACKGROUND = 0,
+        RES_BACK,
+        RES_SUIT_BEGIN,
+        RES_BIG_NUMBER_BEGIN = RES_SUIT_BEGIN + CST_NUM_CARD_SUIT_TYPES,
+        RES_SMALL_NUMBER_BEGIN = RES_BIG_NUMBER_BEGIN + 2 * CFT_NUM_CARD_FACE_TYPES,
+        RES_COUNT = RES_SMALL_NUMBER_BEGIN + 2 * CFT_NUM_CARD_FACE_TYPES
+    };
+    
+    /**
+     * @brief 各类资源的下标，参数无效时返回-1
+     */
+    static int getSuitResId(CardSuitType suit);
+    static int getNumberResId(int begin, CardFaceType face, bool isRed);
+    
+    const std::string& getPath(int resId) const;
+    
+#ifndef GAME_HEADLESS
+    cocos2d::Texture2D* getTexture(int resId);
+#endif
+    
     static CardResConfig* _instance;
+    
+    std::string _paths[RES_COUNT];                  // 资源路径（下标为资源下标）
+    std::vector<std::string> _preloadManifest;      // 预加载清单
+#ifndef GAME_HEADLESS
+    cocos2d::Texture2D* _textures[RES_COUNT];       // 纹理句柄（持有引用）
+    bool _textureResolved[RES_COUNT];               // 是否已尝试解析（失败的不再重复加载）
+#endif
 };
 
 #endif // __CARD_RES_CONFIG_H__
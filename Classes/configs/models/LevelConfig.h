@@ -25,9 +25,60 @@
 #ifndef __LEVEL_CONFIG_H__
 #define __LEVEL_CONFIG_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
+#include <string>
 #include <vector>
 
+/**
+ * @brief 主牌区遮挡关系（按主牌区卡牌列表中的位置引用，随机发牌的关卡同样适用）
+ */
+struct PlayFieldCoverConfig
+{
+    int coverIndex;         // 上层卡牌在主牌区列表中的位置
+    int coveredIndex;       // 被遮挡卡牌在主牌区列表中的位置
+};
+
+/**
+ * @brief 主牌区布局类型
+ */
+enum class PlayFieldLayoutType
+{
+    GRID = 0,       // 网格：按列数逐行排布
+    PYRAMID = 1,    // 金字塔：首行最宽，之后每行少一张并居中，每张牌位于上一行相邻两张之间
+    CUSTOM = 2      // 自定义：逐张给出坐标
+};
+
+/**
+ * @brief 主牌区卡牌坐标（卡牌中心，以主牌区中心为原点，y轴向上）
+ */
+struct PlayFieldPositionConfig
+{
+    float x;
+    float y;
+};
+
+/**
+ * @brief 主牌区布局配置
+ */
+struct PlayFieldLayoutConfig
+{
+    PlayFieldLayoutType type;
+    int columns;                                        // GRID：每行卡牌数
+    float spacingX;                                     // GRID/PYRAMID：同一行相邻卡牌中心的横向距离
+    float spacingY;                                     // GRID/PYRAMID：相邻两行中心的纵向距离
+    std::vector<PlayFieldPositionConfig> positions;     // CUSTOM：按主牌区位置给出的坐标
+    
+    PlayFieldLayoutConfig()
+    : type(PlayFieldLayoutType::GRID)
+    , columns(4)
+    , spacingX(250.0f)
+    , spacingY(400.0f)
+    {
+    }
+};
+
 /**
  * @brief 关卡配置类
  * 存储关卡的静态配置信息
@@ -47,28 +98,45 @@ public:
     /**
      * @brief 获取关卡名称
      */
-    std::string getLevelName() const { return _levelName; }
+    const std::string& getLevelName() const { return _levelName; }
     void setLevelName(const std::string& name) { _levelName = name; }
     
     /**
      * @brief 获取主牌区的初始卡牌配置
      * @return 卡牌ID列表
      */
-    std::vector<int> getPlayFieldCards() const { return _playFieldCards; }
+    const std::vector<int>& getPlayFieldCards() const { return _playFieldCards; }
     void setPlayFieldCards(const std::vector<int>& cards) { _playFieldCards = cards; }
+    void setPlayFieldCards(const int* cards, int count) { _playFieldCards.assign(cards, cards + count); }
     
     /**
      * @brief 获取手牌区的初始卡牌配置
      * @return 卡牌ID列表
      */
-    std::vector<int> getStackCards() const { return _stackCards; }
+    const std::vector<int>& getStackCards() const { return _stackCards; }
     void setStackCards(const std::vector<int>& cards) { _stackCards = cards; }
+    void setStackCards(const int* cards, int count) { _stackCards.assign(cards, cards + count); }
 
+    /**
+     * @brief 获取主牌区的遮挡关系（为空时所有卡牌都可点击）
+     */
+    const std::vector<PlayFieldCoverConfig>& getPlayFieldCovers() const { return _playFieldCovers; }
+    void setPlayFieldCovers(const std::vector<PlayFieldCoverConfig>& covers) { _playFieldCovers = covers; }
+    void setPlayFieldCovers(const PlayFieldCoverConfig* covers, int count) { _playFieldCovers.assign(covers, covers + count); }
+    
+    /**
+     * @brief 获取主牌区布局（默认为4列网格）
+     */
+    const PlayFieldLayoutConfig& getPlayFieldLayout() const { return _playFieldLayout; }
+    void setPlayFieldLayout(const PlayFieldLayoutConfig& layout) { _playFieldLayout = layout; }
+    
 private:
     int _levelId;
     std::string _levelName;
     std::vector<int> _playFieldCards;  // 主牌区卡牌ID列表
     std::vector<int> _stackCards;      // 手牌区卡牌ID列表
+    std::vector<PlayFieldCoverConfig> _playFieldCovers;  // 主牌区遮挡关系
+    PlayFieldLayoutConfig _playFieldLayout;              // 主牌区布局
 };
 
 #endif // __LEVEL_CONFIG_H__
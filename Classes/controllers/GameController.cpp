@@ -26,6 +26,7 @@
 #include "../configs/loaders/LevelConfigLoader.h"
 #include "../configs/models/LevelConfig.h"
 #include "../services/GameModelFromLevelGenerator.h"
+#include "../services/PlayFieldLayoutGenerator.h"
 #include "../models/GameModel.h"
 #include "../views/GameView.h"
 #include "../views/PlayFieldView.h"
@@ -35,24 +36,50 @@
 #include "PlayFieldController.h"
 #include "StackController.h"
 #include "../managers/UndoManager.h"
-#include "../models/UndoModel.h"
+#include "../managers/HintManager.h"
+#include "../models/UndoRecord.h"
 #include "../models/CardModel.h"
+#include "../utils/RandomGenerator.h"
+#include "../utils/TraceRecorder.h"
 #include "base/CCDirector.h"
+#include "platform/CCFileUtils.h"
 
 USING_NS_CC;
 
+namespace
+{
+    /**
+     * @brief 存档文件路径（可写目录下，只保留一份）
+     */
+    std::string getSavedGamePath()
+    {
+        return FileUtils::getInstance()->getWritablePath() + "saved_game.bin";
+    }
+}
+
 GameController::GameController()
 : _gameModel(nullptr)
 , _gameView(nullptr)
 , _playFieldController(nullptr)
 , _stackController(nullptr)
 , _undoManager(nullptr)
+, _hintManager(nullptr)
+, _hintRequested(false)
 , _levelId(0)
+, _levelConfig(nullptr)
+, _dealSeed(0)
+, _moveLogValid(false)
 {
 }
 
 GameController::~GameController()
 {
+    // 先取消后台提示搜索，之后投递回主线程的结果会被丢弃
+    if (_hintManager != nullptr)
+    {
+        delete _hintManager;
+        _hintManager = nullptr;
+    }
     if (_playFieldController != nullptr)
     {
         delete _playFieldController;
@@ -73,6 +100,11 @@ GameController::~GameController()
         delete _gameModel;
         _gameModel = nullptr;
     }
+    if (_levelConfig != nullptr)
+    {
+        delete _levelConfig;
+        _levelConfig = nullptr;
+    }
 }
 
 Scene* GameController::startGame(int levelId)
@@ -87,23 +119,38 @@ Scene* GameController::startGame(int levelId)
     }
     
     // 2. 生成游戏模型
-    _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    // 发牌种子写入操作记录，服务器可据此重新生成同一牌局校验
+    _dealSeed = RandomGenerator::getThreadDefault().next();
+    _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig, _dealSeed);
     if (_gameModel == nullptr)
     {
         delete levelConfig;
         return nullptr;
     }
-    delete levelConfig;
+    // 关卡配置保留到下一次startGame，重新开始时直接复用
+    if (_levelConfig != nullptr)
+    {
+        delete _levelConfig;
+    }
+    _levelConfig = levelConfig;
+    // 视图按模型记录的区域变化增量更新
+    _gameModel->setZoneChangeTracking(true);
     
     // 3. 初始化管理器
     _undoManager = new UndoManager();
     _undoManager->init(_gameModel);
+    _hintManager = new HintManager();
+    _hintRequested = false;
+    _moveLog.reset(_levelId, _dealSeed);
+    _moveLogValid = true;
     
     // 4. 初始化子控制器
     initControllers();
     
-    // 5. 创建游戏视图
-    _gameView = GameView::create(_gameModel);
+    // 5. 创建游戏视图（主牌区按关卡布局摆放）
+    PlayFieldLayout playFieldLayout;
+    PlayFieldLayoutGenerator::generateLayout(_levelConfig, playFieldLayout);
+    _gameView = GameView::create(_gameModel, playFieldLayout);
     if (_gameView == nullptr)
     {
         return nullptr;
@@ -118,6 +165,10 @@ Scene* GameController::startGame(int levelId)
         _playFieldController->setGameStateCheckCallback([this]() {
             this->checkGameState();
         });
+        // 记录操作，并取消旧局面的提示搜索
+        _playFieldController->setMoveStartedCallback([this](const UndoRecord& record) {
+            this->onMoveStarted(record);
+        });
     }
     
     if (_stackController != nullptr && _gameView->getBottomCardView() != nullptr)
@@ -128,12 +179,22 @@ Scene* GameController::startGame(int levelId)
         _stackController->setGameStateCheckCallback([this]() {
             this->checkGameState();
         });
+        // 记录操作，并取消旧局面的提示搜索
+        _stackController->setMoveStartedCallback([this](const UndoRecord& record) {
+            this->onMoveStarted(record);
+        });
     }
     
     // 7. 设置回退按钮回调
     _gameView->setUndoButtonCallback([this]() {
         this->handleUndo();
     });
+    _gameView->setRedoButtonCallback([this]() {
+        this->handleRedo();
+    });
+    _gameView->setHintButtonCallback([this]() {
+        this->handleHint();
+    });
     
     // 8. 设置重新开始和退出回调
     _gameView->setRestartCallback([this]() {
@@ -144,6 +205,9 @@ Scene* GameController::startGame(int levelId)
         this->exitGame();
     });
     
+    // 9. 为开局局面预先计算提示
+    requestHint();
+    
     return _gameView;
 }
 
@@ -162,49 +226,163 @@ void GameController::handleUndo()
         return;  // 没有可撤销的记录
     }
     
-    UndoModel* undoModel = _undoManager->popUndoRecord();
-    if (undoModel == nullptr)
+    const UndoRecord* record = _undoManager->getUndoRecord();
+    if (record == nullptr)
     {
         return;
     }
     
     // 根据操作类型执行相应的撤销
     bool success = false;
-    if (undoModel->getActionType() == UndoActionType::ELIMINATE_CARD)
+    if (record->actionType == UndoActionType::ELIMINATE_CARD)
     {
         if (_playFieldController != nullptr)
         {
-            success = _playFieldController->performUndo(undoModel);
+            success = _playFieldController->performUndo(*record);
         }
     }
-    else if (undoModel->getActionType() == UndoActionType::REPLACE_BOTTOM_CARD)
+    else if (record->actionType == UndoActionType::REPLACE_BOTTOM_CARD)
     {
         if (_stackController != nullptr)
         {
-            success = _stackController->performUndo(undoModel);
+            success = _stackController->performUndo(*record);
         }
     }
     
-    if (!success)
+    // 撤销失败时记录保持不动
+    if (success)
     {
-        // 撤销失败，重新放回栈中
-        _undoManager->pushUndoRecord(undoModel);
+        _undoManager->stepBack();
+        _moveLog.append(MoveLogAction::UNDO);
+        // 撤销后检查游戏状态
+        checkGameState();
     }
-    else
+}
+
+void GameController::handleRedo()
+{
+    if (_undoManager == nullptr || !_undoManager->canRedo())
     {
-        delete undoModel;
-        // 撤销后检查游戏状态
+        return;  // 没有可重做的记录
+    }
+    
+    const UndoRecord* record = _undoManager->getRedoRecord();
+    if (record == nullptr)
+    {
+        return;
+    }
+    
+    // 根据操作类型执行相应的重做
+    bool success = false;
+    if (record->actionType == UndoActionType::ELIMINATE_CARD)
+    {
+        if (_playFieldController != nullptr)
+        {
+            success = _playFieldController->performRedo(*record);
+        }
+    }
+    else if (record->actionType == UndoActionType::REPLACE_BOTTOM_CARD)
+    {
+        if (_stackController != nullptr)
+        {
+            success = _stackController->performRedo(*record);
+        }
+    }
+    
+    if (success)
+    {
+        _undoManager->stepForward();
+        _moveLog.append(MoveLogAction::REDO);
+        // 重做后检查游戏状态
         checkGameState();
     }
 }
 
+void GameController::handleHint()
+{
+    if (_hintManager == nullptr)
+    {
+        return;
+    }
+    
+    if (_hintManager->hasHint())
+    {
+        showHint(_hintManager->getHint());
+        return;
+    }
+    
+    // 搜索仍在进行，结果返回时再显示
+    _hintRequested = true;
+    if (!_hintManager->isSearching())
+    {
+        requestHint();
+    }
+}
+
+void GameController::onMoveStarted(const UndoRecord& record)
+{
+    MoveLogAction action = (record.actionType == UndoActionType::ELIMINATE_CARD) ? MoveLogAction::TAP_PLAY_FIELD : MoveLogAction::TAP_STACK;
+    _moveLog.append(action, record.cardId);
+    
+    // 操作一开始就取消旧局面的提示搜索
+    cancelHint();
+}
+
+void GameController::cancelHint()
+{
+    _hintRequested = false;
+    if (_hintManager != nullptr)
+    {
+        _hintManager->cancel();
+    }
+}
+
+void GameController::requestHint()
+{
+    if (_hintManager == nullptr || _gameModel == nullptr)
+    {
+        return;
+    }
+    
+    _hintManager->requestHint(_gameModel, [this](const HintResult& hint) {
+        if (_hintRequested)
+        {
+            _hintRequested = false;
+            showHint(hint);
+        }
+    });
+}
+
+void GameController::showHint(const HintResult& hint)
+{
+    if (_gameView == nullptr)
+    {
+        return;
+    }
+    
+    if (hint.type == HintResultType::NO_WINNING_LINE)
+    {
+        _gameView->showTip("无法获胜");
+        return;
+    }
+    if (hint.hasMove)
+    {
+        _gameView->highlightCard(hint.move.cardId);
+    }
+}
+
 void GameController::checkGameState()
 {
+    TRACE_ZONE("GameController::checkGameState");
+    
     if (_gameModel == nullptr || _gameView == nullptr)
     {
         return;
     }
     
+    // 局面已变化，旧的提示作废
+    cancelHint();
+    
     // 检查胜利条件：主牌区的牌消耗完了
     const std::vector<int>& playFieldCardIds = _gameModel->getPlayFieldCardIds();
     if (playFieldCardIds.empty())
@@ -224,145 +402,153 @@ void GameController::checkGameState()
             return;  // 没有底牌，无法判断
         }
         
-        const CardModel* bottomCard = _gameModel->getCardById(bottomCardId);
-        if (bottomCard == nullptr)
+        if (!_gameModel->hasCard(bottomCardId))
         {
             return;
         }
         
-        // 检查主牌区是否有与底牌匹配的牌
-        bool hasMatch = false;
-        for (int cardId : playFieldCardIds)
-        {
-            const CardModel* card = _gameModel->getCardById(cardId);
-            if (card != nullptr && card->canMatchWith(bottomCard))
-            {
-                hasMatch = true;
-                break;
-            }
-        }
-        
-        if (!hasMatch)
+        // 检查主牌区是否有与底牌匹配的牌（点数桶计数，O(1)）
+        if (!_gameModel->hasPlayFieldMatch())
         {
             // 显示闯关失败弹窗
             _gameView->showGameResult(GameResultType::DEFEAT);
+            return;
         }
     }
+    
+    // 游戏未结束，在后台为新局面计算提示
+    requestHint();
 }
 
 void GameController::restartGame()
 {
-    // 重新开始游戏：使用相同的关卡ID，不删除GameController，只重新生成数据
-    
-    // 1. 先清理回调并移除弹窗，避免悬空指针
-    if (_gameView != nullptr)
+    // 重新开始游戏：使用相同的关卡ID，原地重新发牌，不重建控制器、视图和场景
+    if (_gameModel == nullptr || _gameView == nullptr || _undoManager == nullptr || _levelConfig == nullptr)
     {
-        // 移除游戏结果弹窗（如果存在）
-        _gameView->removeGameResultView();
-        // 清理回调
-        _gameView->setRestartCallback(nullptr);
-        _gameView->setExitCallback(nullptr);
-        _gameView->setUndoButtonCallback(nullptr);
+        return;
     }
     
-    // 2. 清理旧数据
-    if (_playFieldController != nullptr)
+    // 1. 取消旧局面的提示搜索并移除弹窗
+    cancelHint();
+    _hintRequested = false;
+    _gameView->removeGameResultView();
+    
+    // 2. 恢复快照可能切换了关卡，此时重新加载关卡配置
+    if (!refreshLevelConfig())
     {
-        delete _playFieldController;
-        _playFieldController = nullptr;
+        return;
     }
-    if (_stackController != nullptr)
+    
+    // 3. 按新种子在原模型中重新发牌（子控制器和撤销管理器持有的模型指针保持有效）
+    _dealSeed = RandomGenerator::getThreadDefault().next();
+    if (!GameModelFromLevelGenerator::regenerateGameModel(_levelConfig, _dealSeed, _gameModel))
     {
-        delete _stackController;
-        _stackController = nullptr;
+        return;
     }
-    if (_undoManager != nullptr)
+    
+    // 4. 清空撤销记录和操作记录（保留已分配的容量）
+    _undoManager->clear();
+    _moveLog.reset(_levelId, _dealSeed);
+    _moveLogValid = true;
+    
+    // 5. 卡牌视图全部回收到对象池，再按新牌局取出并重新绑定
+    _gameView->rebuildView(_gameModel);
+    
+    // 6. 为开局局面预先计算提示
+    requestHint();
+}
+
+size_t GameController::saveSnapshot(void* buffer, size_t capacity)
+{
+    if (_gameModel == nullptr || _undoManager == nullptr)
     {
-        delete _undoManager;
-        _undoManager = nullptr;
+        return 0;
     }
-    if (_gameModel != nullptr)
+    
+    // 只保存可撤销的步骤，重做记录不进入存档
+    return GameSnapshot::write(_gameModel, _undoManager->getRecords(), _undoManager->getMoveCount(), buffer, capacity);
+}
+
+bool GameController::restoreSnapshot(const void* buffer, size_t size)
+{
+    if (_gameModel == nullptr || _undoManager == nullptr || _gameView == nullptr)
     {
-        delete _gameModel;
-        _gameModel = nullptr;
+        return false;
     }
     
-    // 3. 移除旧的游戏视图（但不删除GameController）
-    if (_gameView != nullptr)
+    if (!GameSnapshot::read(buffer, size, _gameModel, &_snapshotUndoRecords))
     {
-        // 先取消所有定时器和动作，避免回调执行时对象已删除
-        _gameView->unscheduleAllSelectors();
-        _gameView->stopAllActions();
-        _gameView->removeFromParent();
-        _gameView = nullptr;
+        return false;
     }
-    
-    // 4. 重新生成游戏数据
-    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(_levelId);
-    if (levelConfig == nullptr)
+    _levelId = _gameModel->getLevelId();
+    _undoManager->assignRecords(_snapshotUndoRecords.data(), _snapshotUndoRecords.size());
+    
+    // 快照不含发牌种子，恢复后的牌局无法从开局重放
+    _moveLog.reset(_levelId, 0);
+    _moveLogValid = false;
+    
+    // 恢复后的牌局可能已结束，先移除旧弹窗再按该关卡的布局重建视图
+    _gameView->removeGameResultView();
+    refreshLevelConfig();
+    _gameView->rebuildView(_gameModel);
+    checkGameState();
+    return true;
+}
+
+bool GameController::saveGame()
+{
+    if (_gameModel == nullptr || _undoManager == nullptr)
     {
-        return;
+        return false;
     }
     
-    _gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
-    delete levelConfig;
-    
-    if (_gameModel == nullptr)
+    _snapshotBuffer.resize(GameSnapshot::getSnapshotSize(_gameModel, _undoManager->getMoveCount()));
+    size_t size = saveSnapshot(_snapshotBuffer.data(), _snapshotBuffer.size());
+    if (size == 0)
     {
-        return;
+        return false;
     }
     
-    // 5. 重新初始化管理器
-    _undoManager = new UndoManager();
-    _undoManager->init(_gameModel);
-    
-    // 6. 重新初始化子控制器
-    initControllers();
-    
-    // 7. 创建新的游戏视图
-    _gameView = GameView::create(_gameModel);
-    if (_gameView == nullptr)
+    Data data;
+    data.copy(_snapshotBuffer.data(), (ssize_t)size);
+    return FileUtils::getInstance()->writeDataToFile(data, getSavedGamePath());
+}
+
+bool GameController::resumeSavedGame()
+{
+    std::string path = getSavedGamePath();
+    if (!FileUtils::getInstance()->isFileExist(path))
     {
-        return;
+        return false;
     }
-    
-    // 8. 初始化各子控制器和视图
-    if (_playFieldController != nullptr && _gameView->getBottomCardView() != nullptr)
+    if (FileUtils::getInstance()->getContents(path, &_snapshotBuffer) != FileUtils::Status::OK)
     {
-        _playFieldController->init(_gameModel, _undoManager, _gameView->getBottomCardView());
-        _playFieldController->initView(_gameView->getPlayFieldView());
-        // 设置游戏状态检查回调
-        _playFieldController->setGameStateCheckCallback([this]() {
-            this->checkGameState();
-        });
+        return false;
     }
     
-    if (_stackController != nullptr && _gameView->getBottomCardView() != nullptr)
+    // 校验失败（版本不符、文件损坏）时快照读取不会修改牌局
+    return restoreSnapshot(_snapshotBuffer.data(), _snapshotBuffer.size());
+}
+
+bool GameController::refreshLevelConfig()
+{
+    if (_levelConfig != nullptr && _levelConfig->getLevelId() == _levelId)
     {
-        _stackController->init(_gameModel, _undoManager, _gameView->getBottomCardView());
-        _stackController->initView(_gameView->getStackView());
-        // 设置游戏状态检查回调
-        _stackController->setGameStateCheckCallback([this]() {
-            this->checkGameState();
-        });
+        return true;
     }
     
-    // 9. 设置回退按钮回调
-    _gameView->setUndoButtonCallback([this]() {
-        this->handleUndo();
-    });
-    
-    // 10. 设置重新开始和退出回调
-    _gameView->setRestartCallback([this]() {
-        this->restartGame();
-    });
-    
-    _gameView->setExitCallback([this]() {
-        this->exitGame();
-    });
+    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(_levelId);
+    if (levelConfig == nullptr)
+    {
+        return false;
+    }
+    delete _levelConfig;
+    _levelConfig = levelConfig;
     
-    // 11. 替换场景
-    Director::getInstance()->replaceScene(_gameView);
+    PlayFieldLayout playFieldLayout;
+    PlayFieldLayoutGenerator::generateLayout(_levelConfig, playFieldLayout);
+    _gameView->setPlayFieldLayout(playFieldLayout);
+    return true;
 }
 
 void GameController::exitGame()
@@ -26,13 +26,19 @@
 #define __GAME_CONTROLLER_H__
 
 #include "cocos2d.h"
+#include "../services/GameSnapshot.h"
+#include "../models/MoveLog.h"
+#include <vector>
 
 // 前向声明
 class GameModel;
 class GameView;
+class LevelConfig;
 class PlayFieldController;
 class StackController;
 class UndoManager;
+class HintManager;
+struct HintResult;
 
 /**
  * @brief 游戏主控制器
@@ -56,14 +62,26 @@ public:
      */
     void handleUndo();
     
+    /**
+     * @brief 处理重做操作（重新执行最近一次撤销的步骤）
+     */
+    void handleRedo();
+    
+    /**
+     * @brief 处理提示请求：已有结果时立即显示，否则在后台搜索完成时显示
+     */
+    void handleHint();
+    
     /**
      * @brief 检查游戏状态（胜利/失败）
-     * 在每次操作后调用，检查是否满足游戏结束条件
+     * 在每次操作后调用，检查是否满足游戏结束条件，未结束时为新局面发起后台提示搜索
      */
     void checkGameState();
     
     /**
      * @brief 重新开始游戏
+     * 原地重开：复用模型、管理器、子控制器和游戏视图，按新种子重新发牌，
+     * 卡牌视图回收到对象池后重新绑定，不重建场景
      */
     void restartGame();
     
@@ -71,6 +89,40 @@ public:
      * @brief 退出游戏
      */
     void exitGame();
+    
+    /**
+     * @brief 将当前牌局和撤销记录写入二进制快照（自动存档、崩溃恢复）
+     * @param buffer 目标缓冲区
+     * @param capacity 缓冲区大小，所需大小见GameSnapshot::getSnapshotSize
+     * @return 写入的字节数，失败返回0
+     */
+    size_t saveSnapshot(void* buffer, size_t capacity);
+    
+    /**
+     * @brief 从二进制快照恢复牌局和撤销记录，并刷新视图
+     * @param buffer 快照数据
+     * @param size 快照字节数
+     * @return 是否恢复成功
+     */
+    bool restoreSnapshot(const void* buffer, size_t size);
+    
+    /**
+     * @brief 把当前牌局存档到可写目录（切到后台时调用，进程可能随后被系统结束）
+     * @return 是否写入成功
+     */
+    bool saveGame();
+    
+    /**
+     * @brief 读取可写目录中的存档并恢复（启动时调用），没有存档或存档无效时保留当前牌局
+     * @return 是否恢复成功
+     */
+    bool resumeSavedGame();
+    
+    /**
+     * @brief 获取本局的操作记录（发牌种子、关卡ID和所有点击/回退/重做），可提交给服务器用MoveLogVerifier校验
+     * @return 操作记录，恢复快照后的牌局无法从开局重放，返回nullptr
+     */
+    const MoveLog* getMoveLog() const { return _moveLogValid ? &_moveLog : nullptr; }
 
 private:
     /**
@@ -78,12 +130,47 @@ private:
      */
     void initControllers();
     
+    /**
+     * @brief 为当前局面发起后台提示搜索（取消进行中的搜索）
+     */
+    void requestHint();
+    
+    /**
+     * @brief 取消进行中的提示搜索并丢弃已有结果（局面变化时调用）
+     */
+    void cancelHint();
+    
+    /**
+     * @brief 玩家点击主牌区或备用牌堆、模型已更新时调用：记录操作并取消旧提示
+     * @param record 本步的撤销记录
+     */
+    void onMoveStarted(const UndoRecord& record);
+    
+    /**
+     * @brief 在视图上显示提示结果
+     */
+    void showHint(const HintResult& hint);
+    
+    /**
+     * @brief 确保关卡配置对应当前关卡（恢复快照可能切换了关卡），并把主牌区布局应用到视图
+     * @return 关卡配置是否可用
+     */
+    bool refreshLevelConfig();
+    
     GameModel* _gameModel;                    // 游戏模型
     GameView* _gameView;                      // 游戏视图
     PlayFieldController* _playFieldController; // 主牌区控制器
     StackController* _stackController;         // 手牌区控制器
     UndoManager* _undoManager;                // 撤销管理器
+    HintManager* _hintManager;                // 提示管理器
+    bool _hintRequested;                      // 玩家已请求提示但结果尚未返回
     int _levelId;                             // 当前关卡ID
+    LevelConfig* _levelConfig;                // 当前关卡配置（重新开始时复用）
+    uint64_t _dealSeed;                       // 当前牌局的发牌种子
+    MoveLog _moveLog;                         // 本局操作记录
+    bool _moveLogValid;                       // 操作记录是否从开局开始（恢复快照后为false）
+    std::vector<UndoRecord> _snapshotUndoRecords;  // 快照读写时复用的撤销记录缓冲
+    std::vector<unsigned char> _snapshotBuffer;    // 存档读写时复用的快照缓冲
 };
 
 #endif // __GAME_CONTROLLER_H__
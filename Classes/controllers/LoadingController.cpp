@@ -0,0 +1,125 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "LoadingController.h"
+#include "../configs/models/CardResConfig.h"
+#include "../managers/TexturePreloadManager.h"
+#include "../services/RenderOnDemandService.h"
+#include "../views/CardAtlas.h"
+#include "../views/LoadingView.h"
+
+USING_NS_CC;
+
+LoadingController::LoadingController()
+: _loadingView(nullptr)
+, _preloadManager(nullptr)
+{
+    _preloadManager = new TexturePreloadManager();
+}
+
+LoadingController::~LoadingController()
+{
+    if (_loadingView != nullptr)
+    {
+        _loadingView->unschedule("finish_loading");
+        _loadingView->release();
+        _loadingView = nullptr;
+        RenderOnDemandService::releaseWakeLock();
+    }
+    
+    if (_preloadManager != nullptr)
+    {
+        delete _preloadManager;
+        _preloadManager = nullptr;
+    }
+}
+
+Scene* LoadingController::startLoading(const NextSceneCreator& nextSceneCreator)
+{
+    _nextSceneCreator = nextSceneCreator;
+    _loadingView = LoadingView::create();
+    if (_loadingView == nullptr)
+    {
+        return nullptr;
+    }
+    // 持有引用：控制器销毁时场景可能已被Director释放
+    _loadingView->retain();
+    // 异步加载的回调和进度条都依赖调度器，加载期间保持出帧
+    RenderOnDemandService::acquireWakeLock();
+    
+    _preloadManager->start(CardResConfig::getInstance()->getPreloadManifest(),
+                           [this](int loadedCount, int totalCount) {
+                               this->onLoadProgress(loadedCount, totalCount);
+                           },
+                           [this]() {
+                               this->onLoadComplete();
+                           });
+    return _loadingView;
+}
+
+void LoadingController::onLoadProgress(int loadedCount, int totalCount)
+{
+    if (_loadingView != nullptr && totalCount > 0)
+    {
+        _loadingView->setProgress((float)loadedCount / totalCount);
+    }
+}
+
+void LoadingController::onLoadComplete()
+{
+    if (_loadingView == nullptr)
+    {
+        return;
+    }
+    
+    // 场景运行后的下一帧执行，此时100%的进度也已显示
+    _loadingView->scheduleOnce([this](float dt) {
+        this->finishLoading();
+    }, 0.0f, "finish_loading");
+}
+
+void LoadingController::finishLoading()
+{
+    // 运行中的场景仍被Director持有，切换完成后才会释放
+    if (_loadingView != nullptr)
+    {
+        _loadingView->release();
+        _loadingView = nullptr;
+        RenderOnDemandService::releaseWakeLock();
+    }
+    
+    // 纹理已全部在缓存中，解析句柄和合成图集不再解码图片
+    CardResConfig::getInstance()->bindTextures();
+    CardAtlas::getInstance()->build();
+    
+    if (_nextSceneCreator != nullptr)
+    {
+        Scene* nextScene = _nextSceneCreator();
+        if (nextScene != nullptr)
+        {
+            Director::getInstance()->replaceScene(nextScene);
+        }
+    }
+}
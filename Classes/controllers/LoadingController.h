@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __LOADING_CONTROLLER_H__
+#define __LOADING_CONTROLLER_H__
+
+#include "cocos2d.h"
+#include <functional>
+
+// 前向声明
+class LoadingView;
+class TexturePreloadManager;
+
+/**
+ * @brief 加载控制器
+ * 显示加载场景，按CardResConfig的预加载清单异步加载卡牌纹理并更新进度，
+ * 完成后解析纹理句柄、合成卡牌图集，再切换到下一个场景
+ */
+class LoadingController
+{
+public:
+    typedef std::function<cocos2d::Scene*()> NextSceneCreator;
+    
+    LoadingController();
+    virtual ~LoadingController();
+    
+    /**
+     * @brief 开始加载
+     * @param nextSceneCreator 加载完成后创建下一个场景（在主线程调用）
+     * @return 加载场景，由调用方运行
+     */
+    cocos2d::Scene* startLoading(const NextSceneCreator& nextSceneCreator);
+
+private:
+    /**
+     * @brief 单张纹理加载完成
+     */
+    void onLoadProgress(int loadedCount, int totalCount);
+    
+    /**
+     * @brief 全部纹理加载完成，延后一帧切换场景（清单已全部缓存时完成回调发生在startLoading返回之前）
+     */
+    void onLoadComplete();
+    
+    /**
+     * @brief 解析纹理句柄、合成图集并切换到下一个场景
+     */
+    void finishLoading();
+
+private:
+    LoadingView* _loadingView;                  // 加载场景（加载期间持有引用）
+    TexturePreloadManager* _preloadManager;     // 纹理预加载管理器
+    NextSceneCreator _nextSceneCreator;         // 下一个场景的创建函数
+};
+
+#endif // __LOADING_CONTROLLER_H__
@@ -25,12 +25,12 @@
 #include "PlayFieldController.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
-#include "../models/UndoModel.h"
+#include "../models/UndoRecord.h"
 #include "../views/PlayFieldView.h"
 #include "../views/BottomCardView.h"
 #include "../views/CardView.h"
 #include "../managers/UndoManager.h"
-#include "../utils/CommonUtils.h"
+#include "../utils/TraceRecorder.h"
 #include <algorithm>
 
 USING_NS_CC;
@@ -69,6 +69,8 @@ void PlayFieldController::initView(PlayFieldView* playFieldView)
 
 bool PlayFieldController::handleCardClick(int cardId)
 {
+    TRACE_ZONE("PlayFieldController::handleCardClick");
+    
     if (_gameModel == nullptr || _playFieldView == nullptr || _bottomCardView == nullptr)
     {
         return false;
@@ -81,47 +83,44 @@ bool PlayFieldController::handleCardClick(int cardId)
         return false;  // 没有底牌
     }
     
-    // 获取点击的卡牌和底牌
-    CardModel* clickedCard = _gameModel->getCardById(cardId);
-    const CardModel* bottomCard = _gameModel->getCardById(bottomCardId);
-    
-    if (clickedCard == nullptr || bottomCard == nullptr)
+    // 检查是否匹配（点数差1）
+    if (!_gameModel->hasCard(cardId) || !_gameModel->hasCard(bottomCardId))
     {
         return false;
     }
-    
-    // 检查是否匹配（点数差1）
-    if (!clickedCard->canMatchWith(bottomCard))
+    if (!_gameModel->isCardExposed(cardId))
+    {
+        return false;  // 被上层卡牌遮挡
+    }
+    if (!_gameModel->canCardsMatch(cardId, bottomCardId))
     {
         return false;  // 不匹配，不能消除
     }
     
     // 记录撤销信息
-    UndoModel* undoModel = new UndoModel();
-    undoModel->setActionType(UndoActionType::ELIMINATE_CARD);
-    undoModel->setCardId(cardId);  // 新底牌（主牌堆的牌）
-    undoModel->setReplacedCardId(bottomCardId);  // 被替换的底牌
-    
-    // 保存卡牌数据
-    undoModel->setCardModel(CommonUtils::cloneCardModel(clickedCard));
-    undoModel->setReplacedCardModel(CommonUtils::cloneCardModel(bottomCard));
+    UndoRecord record = {};
+    record.actionType = UndoActionType::ELIMINATE_CARD;
+    record.cardId = cardId;  // 新底牌（主牌堆的牌）
+    record.replacedCardId = bottomCardId;  // 被替换的底牌
+    record.playFieldIndex = _gameModel->getPlayFieldIndex(cardId);
     
-    // 保存位置信息
     CardView* clickedCardView = _playFieldView->getCardView(cardId);
     CardView* bottomCardView = _bottomCardView->getCardView();
-    if (clickedCardView != nullptr)
-    {
-        undoModel->setCardPosition(clickedCardView->getPosition());
-    }
-    if (bottomCardView != nullptr)
-    {
-        undoModel->setReplacedCardPosition(bottomCardView->getPosition());
-    }
     
     // 更新模型：从主牌堆移除该卡牌，设置为新的底牌
     _gameModel->removeFromPlayField(cardId);
     _gameModel->setBottomCardId(cardId);
     
+    // 添加到撤销记录（先于动画和状态检查，回调中可读取到本步记录）
+    if (_undoManager != nullptr)
+    {
+        _undoManager->pushUndoRecord(record);
+    }
+    if (_moveStartedCallback != nullptr)
+    {
+        _moveStartedCallback(record);
+    }
+    
     // 播放替换动画：主牌堆的牌平移到底牌位置
     if (clickedCardView != nullptr && bottomCardView != nullptr)
     {
@@ -130,7 +129,7 @@ bool PlayFieldController::handleCardClick(int cardId)
         Vec2 worldPos = _bottomCardView->convertToWorldSpace(targetPos);
         Vec2 localPos = _playFieldView->convertToNodeSpace(worldPos);
         
-        clickedCardView->playMoveAnimation(localPos, 0.3f, [this, cardId]() {
+        _playFieldView->playCardMoveAnimation(cardId, localPos, 0.3f, [this, cardId]() {
             // 动画完成后更新视图
             if (_playFieldView != nullptr && _bottomCardView != nullptr && _gameModel != nullptr)
             {
@@ -156,34 +155,53 @@ bool PlayFieldController::handleCardClick(int cardId)
         }
     }
     
-    // 添加到撤销记录
-    if (_undoManager != nullptr)
+    return true;
+}
+
+bool PlayFieldController::performUndo(const UndoRecord& record)
+{
+    TRACE_ZONE("PlayFieldController::performUndo");
+    
+    if (_gameModel == nullptr || _playFieldView == nullptr || _bottomCardView == nullptr)
     {
-        _undoManager->pushUndoRecord(undoModel);
+        return false;
     }
     
+    if (record.actionType != UndoActionType::ELIMINATE_CARD)
+    {
+        return false;
+    }
+    
+    // 恢复模型：将底牌恢复，主牌堆的牌放回原位置
+    if (!UndoManager::revertRecord(_gameModel, record))
+    {
+        return false;
+    }
+    
+    // 更新视图
+    _playFieldView->updateView(_gameModel);
+    _bottomCardView->updateView(_gameModel);
+    
     return true;
 }
 
-bool PlayFieldController::performUndo(UndoModel* undoModel)
+bool PlayFieldController::performRedo(const UndoRecord& record)
 {
-    if (undoModel == nullptr || _gameModel == nullptr || _playFieldView == nullptr || _bottomCardView == nullptr)
+    if (_gameModel == nullptr || _playFieldView == nullptr || _bottomCardView == nullptr)
     {
         return false;
     }
     
-    if (undoModel->getActionType() != UndoActionType::ELIMINATE_CARD)
+    if (record.actionType != UndoActionType::ELIMINATE_CARD)
     {
         return false;
     }
     
-    int newCardId = undoModel->getCardId();  // 主牌堆的牌（现在是底牌）
-    int oldCardId = undoModel->getReplacedCardId();  // 原底牌
-    
-    // 恢复模型：将底牌恢复，主牌堆恢复卡牌
-    _gameModel->setBottomCardId(oldCardId);
-    std::vector<int>& playFieldCardIds = _gameModel->getPlayFieldCardIds();
-    playFieldCardIds.push_back(newCardId);
+    // 重新消除：主牌堆的牌再次成为底牌
+    if (!UndoManager::applyRecord(_gameModel, record))
+    {
+        return false;
+    }
     
     // 更新视图
     _playFieldView->updateView(_gameModel);
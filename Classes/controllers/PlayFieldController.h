@@ -66,16 +66,29 @@ public:
     
     /**
      * @brief 执行撤销操作
-     * @param undoModel 撤销数据模型
+     * @param record 撤销记录
      * @return 是否成功
      */
-    bool performUndo(class UndoModel* undoModel);
+    bool performUndo(const struct UndoRecord& record);
+    
+    /**
+     * @brief 执行重做操作
+     * @param record 重做记录
+     * @return 是否成功
+     */
+    bool performRedo(const struct UndoRecord& record);
     
     /**
      * @brief 设置游戏状态检查回调
      * @param callback 回调函数（在操作完成后调用）
      */
     void setGameStateCheckCallback(const std::function<void()>& callback) { _gameStateCheckCallback = callback; }
+    
+    /**
+     * @brief 设置操作开始回调
+     * @param callback 回调函数（模型更新并记录撤销后、动画播放前调用，参数为本步的撤销记录）
+     */
+    void setMoveStartedCallback(const std::function<void(const struct UndoRecord& record)>& callback) { _moveStartedCallback = callback; }
 
 private:
     GameModel* _gameModel;              // 游戏模型
@@ -83,6 +96,7 @@ private:
     class BottomCardView* _bottomCardView; // 底牌视图
     UndoManager* _undoManager;           // 撤销管理器
     std::function<void()> _gameStateCheckCallback;  // 游戏状态检查回调
+    std::function<void(const struct UndoRecord& record)> _moveStartedCallback;  // 操作开始回调
 };
 
 #endif // __PLAY_FIELD_CONTROLLER_H__
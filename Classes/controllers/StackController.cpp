@@ -25,12 +25,12 @@
 #include "StackController.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
-#include "../models/UndoModel.h"
+#include "../models/UndoRecord.h"
 #include "../views/StackView.h"
 #include "../views/BottomCardView.h"
 #include "../views/CardView.h"
 #include "../managers/UndoManager.h"
-#include "../utils/CommonUtils.h"
+#include "../utils/TraceRecorder.h"
 #include <algorithm>
 
 USING_NS_CC;
@@ -69,6 +69,8 @@ void StackController::initView(StackView* stackView)
 
 bool StackController::handleCardClick(int cardId)
 {
+    TRACE_ZONE("StackController::handleCardClick");
+    
     if (_gameModel == nullptr || _stackView == nullptr || _bottomCardView == nullptr)
     {
         return false;
@@ -91,39 +93,29 @@ bool StackController::handleCardClick(int cardId)
     int currentBottomCardId = _gameModel->getBottomCardId();
     
     // 记录撤销信息
-    UndoModel* undoModel = new UndoModel();
-    undoModel->setActionType(UndoActionType::REPLACE_BOTTOM_CARD);
-    undoModel->setCardId(topCardId);  // 新底牌
-    undoModel->setReplacedCardId(currentBottomCardId);  // 被替换的底牌
-    
-    // 保存卡牌数据
-    CardModel* topCard = _gameModel->getCardById(topCardId);
-    const CardModel* bottomCard = _gameModel->getCardById(currentBottomCardId);
-    if (topCard != nullptr)
-    {
-        undoModel->setCardModel(CommonUtils::cloneCardModel(topCard));
-    }
-    if (bottomCard != nullptr)
-    {
-        undoModel->setReplacedCardModel(CommonUtils::cloneCardModel(bottomCard));
-    }
+    UndoRecord record = {};
+    record.actionType = UndoActionType::REPLACE_BOTTOM_CARD;
+    record.cardId = topCardId;  // 新底牌
+    record.replacedCardId = currentBottomCardId;  // 被替换的底牌
+    record.playFieldIndex = -1;
     
-    // 保存位置信息
     CardView* topCardView = _stackView->getCardView(topCardId);
-    if (topCardView != nullptr)
-    {
-        undoModel->setCardPosition(topCardView->getPosition());
-    }
     CardView* bottomCardView = _bottomCardView->getCardView();
-    if (bottomCardView != nullptr)
-    {
-        undoModel->setReplacedCardPosition(bottomCardView->getPosition());
-    }
     
     // 更新模型：从备用牌堆移除顶部牌，设置为新的底牌
     _gameModel->removeTopFromStack();
     _gameModel->setBottomCardId(topCardId);
     
+    // 添加到撤销记录（先于动画和状态检查，回调中可读取到本步记录）
+    if (_undoManager != nullptr)
+    {
+        _undoManager->pushUndoRecord(record);
+    }
+    if (_moveStartedCallback != nullptr)
+    {
+        _moveStartedCallback(record);
+    }
+    
     // 播放替换动画：备用牌堆的牌平移到底牌位置
     if (topCardView != nullptr && bottomCardView != nullptr)
     {
@@ -158,33 +150,53 @@ bool StackController::handleCardClick(int cardId)
         }
     }
     
-    // 添加到撤销记录
-    if (_undoManager != nullptr)
+    return true;
+}
+
+bool StackController::performUndo(const UndoRecord& record)
+{
+    TRACE_ZONE("StackController::performUndo");
+    
+    if (_gameModel == nullptr || _stackView == nullptr || _bottomCardView == nullptr)
+    {
+        return false;
+    }
+    
+    if (record.actionType != UndoActionType::REPLACE_BOTTOM_CARD)
     {
-        _undoManager->pushUndoRecord(undoModel);
+        return false;
+    }
+    
+    // 恢复模型：将底牌恢复，备用牌堆恢复顶部牌
+    if (!UndoManager::revertRecord(_gameModel, record))
+    {
+        return false;
     }
     
+    // 更新视图
+    _stackView->updateView(_gameModel);
+    _bottomCardView->updateView(_gameModel);
+    
     return true;
 }
 
-bool StackController::performUndo(UndoModel* undoModel)
+bool StackController::performRedo(const UndoRecord& record)
 {
-    if (undoModel == nullptr || _gameModel == nullptr || _stackView == nullptr || _bottomCardView == nullptr)
+    if (_gameModel == nullptr || _stackView == nullptr || _bottomCardView == nullptr)
     {
         return false;
     }
     
-    if (undoModel->getActionType() != UndoActionType::REPLACE_BOTTOM_CARD)
+    if (record.actionType != UndoActionType::REPLACE_BOTTOM_CARD)
     {
         return false;
     }
     
-    int newCardId = undoModel->getCardId();
-    int oldCardId = undoModel->getReplacedCardId();
-    
-    // 恢复模型：将底牌恢复，备用牌堆恢复顶部牌
-    _gameModel->setBottomCardId(oldCardId);
-    _gameModel->addToStackTop(newCardId);
+    // 重新翻牌：备用牌堆顶部牌再次成为底牌
+    if (!UndoManager::applyRecord(_gameModel, record))
+    {
+        return false;
+    }
     
     // 更新视图
     _stackView->updateView(_gameModel);
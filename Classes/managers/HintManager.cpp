@@ -0,0 +1,148 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "HintManager.h"
+#include "../models/GameModel.h"
+#include "../services/RenderOnDemandService.h"
+#include "base/CCAsyncTaskPool.h"
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+
+USING_NS_CC;
+
+HintManager::HintManager()
+: _searching(false)
+, _hasHint(false)
+{
+    _hint.type = HintResultType::UNKNOWN;
+    _hint.hasMove = false;
+    _hint.move = { SolverMoveType::STACK_CARD, 0 };
+    _hint.movesToWin = 0;
+}
+
+HintManager::~HintManager()
+{
+    cancel();
+}
+
+void HintManager::requestHint(const GameModel* gameModel, const HintCallback& callback)
+{
+    cancel();
+    if (gameModel == nullptr)
+    {
+        return;
+    }
+    
+    // 工作线程只访问牌局副本和自己的取消标志（副本不复制区域变化记录，也不记录新的变化）
+    std::shared_ptr<std::atomic<bool>> cancelFlag = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<GameModel> snapshot = std::make_shared<GameModel>(*gameModel);
+    _cancelFlag = cancelFlag;
+    _searching = true;
+    // 结果通过主线程调度投递，搜索期间不能停止出帧
+    RenderOnDemandService::acquireWakeLock();
+    
+    HintManager* manager = this;
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, [manager, cancelFlag, snapshot, callback]() {
+        if (cancelFlag->load())
+        {
+            return;
+        }
+        HintResult result = computeHint(snapshot.get(), HINT_MAX_STATES, cancelFlag.get());
+        
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread([manager, cancelFlag, callback, result]() {
+            // 取消与投递都在主线程执行：未取消说明manager仍然有效且结果对应当前牌局
+            if (cancelFlag->load())
+            {
+                return;
+            }
+            manager->_searching = false;
+            RenderOnDemandService::releaseWakeLock();
+            manager->_hasHint = true;
+            manager->_hint = result;
+            if (callback != nullptr)
+            {
+                callback(result);
+            }
+        });
+    });
+}
+
+void HintManager::cancel()
+{
+    if (_cancelFlag != nullptr)
+    {
+        _cancelFlag->store(true);
+        _cancelFlag.reset();
+    }
+    if (_searching)
+    {
+        RenderOnDemandService::releaseWakeLock();
+    }
+    _searching = false;
+    _hasHint = false;
+}
+
+HintResult HintManager::computeHint(const GameModel* gameModel, size_t maxStates, const std::atomic<bool>* cancelFlag)
+{
+    HintResult hint;
+    hint.type = HintResultType::UNKNOWN;
+    hint.hasMove = false;
+    hint.move = { SolverMoveType::STACK_CARD, 0 };
+    hint.movesToWin = 0;
+    if (gameModel == nullptr || gameModel->getPlayFieldCardIds().empty())
+    {
+        return hint;
+    }
+    
+    SolverResult result = GameSolver::solve(gameModel, maxStates, cancelFlag);
+    if (result.solvable && !result.moves.empty())
+    {
+        hint.type = HintResultType::WINNING_MOVE;
+        hint.hasMove = true;
+        hint.move = result.moves.front();
+        hint.movesToWin = (int)result.moves.size();
+        return hint;
+    }
+    if (result.completed)
+    {
+        hint.type = HintResultType::NO_WINNING_LINE;
+        return hint;
+    }
+    
+    // 超出上限：给出任意合法步骤，优先消除
+    std::vector<int> matches;
+    gameModel->collectPlayFieldMatches(gameModel->getBottomCardId(), matches);
+    if (!matches.empty())
+    {
+        hint.hasMove = true;
+        hint.move = { SolverMoveType::PLAY_FIELD_CARD, matches.front() };
+    }
+    else if (!gameModel->getStackCardIds().empty())
+    {
+        hint.hasMove = true;
+        hint.move = { SolverMoveType::STACK_CARD, gameModel->getStackCardIds().back() };
+    }
+    return hint;
+}
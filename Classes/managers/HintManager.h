@@ -0,0 +1,118 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __HINT_MANAGER_H__
+#define __HINT_MANAGER_H__
+
+#include "../services/GameSolver.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// 前向声明
+class GameModel;
+
+/**
+ * @brief 提示结果类型
+ */
+enum class HintResultType
+{
+    WINNING_MOVE,       // 找到获胜步骤，move为其第一步
+    NO_WINNING_LINE,    // 已证明无法获胜
+    UNKNOWN             // 搜索超出上限，move为任意一个合法步骤（如有）
+};
+
+/**
+ * @brief 提示结果
+ */
+struct HintResult
+{
+    HintResultType type;    // 结果类型
+    bool hasMove;           // move是否有效
+    SolverMove move;        // 建议的下一步
+    int movesToWin;         // 获胜所需步数（WINNING_MOVE时有效）
+};
+
+/**
+ * @brief 提示管理器
+ * 每次操作后从当前牌局的副本出发，在AsyncTaskPool工作线程上做有上限的求解，
+ * 结果通过Scheduler::performFunctionInCocosThread投递回主线程，主线程从不等待
+ * 新的请求、撤销或销毁会取消进行中的搜索，被取消的结果不会投递
+ * 禁止实现为单例模式，作为controller的成员变量
+ */
+class HintManager
+{
+public:
+    typedef std::function<void(const HintResult& result)> HintCallback;
+    
+    static const size_t HINT_MAX_STATES = 1 << 18;  // 单次提示搜索的状态上限
+    
+    HintManager();
+    virtual ~HintManager();
+    
+    /**
+     * @brief 取消进行中的搜索，并为当前牌局发起新的搜索
+     * @param gameModel 当前牌局（在主线程复制，之后可继续修改）
+     * @param callback 结果回调（在主线程调用，取消后不会调用）
+     */
+    void requestHint(const GameModel* gameModel, const HintCallback& callback);
+    
+    /**
+     * @brief 取消进行中的搜索并丢弃已有结果
+     */
+    void cancel();
+    
+    /**
+     * @brief 是否有搜索正在进行
+     */
+    bool isSearching() const { return _searching; }
+    
+    /**
+     * @brief 是否已有当前牌局的提示结果
+     */
+    bool hasHint() const { return _hasHint; }
+    
+    /**
+     * @brief 获取当前牌局的提示结果（hasHint为true时有效）
+     */
+    const HintResult& getHint() const { return _hint; }
+    
+    /**
+     * @brief 同步计算提示（纯数据，不依赖引擎，可在任意线程调用）
+     * @param gameModel 游戏模型（只读）
+     * @param maxStates 状态上限
+     * @param cancelFlag 取消标志（可为nullptr）
+     * @return 提示结果
+     */
+    static HintResult computeHint(const GameModel* gameModel, size_t maxStates, const std::atomic<bool>* cancelFlag);
+
+private:
+    std::shared_ptr<std::atomic<bool>> _cancelFlag;    // 进行中搜索的取消标志
+    bool _searching;                                    // 是否有搜索正在进行
+    bool _hasHint;                                      // 是否已有结果
+    HintResult _hint;                                   // 最近一次结果
+};
+
+#endif // __HINT_MANAGER_H__
@@ -0,0 +1,124 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "TexturePreloadManager.h"
+#include "base/CCDirector.h"
+#include "renderer/CCTextureCache.h"
+
+USING_NS_CC;
+
+TexturePreloadManager::TexturePreloadManager()
+: _loadedCount(0)
+, _loading(false)
+{
+}
+
+TexturePreloadManager::~TexturePreloadManager()
+{
+    cancel();
+}
+
+void TexturePreloadManager::start(const std::vector<std::string>& paths, const ProgressCallback& progressCallback,
+                                  const CompleteCallback& completeCallback)
+{
+    cancel();
+    
+    _paths = paths;
+    _loadedCount = 0;
+    _progressCallback = progressCallback;
+    _completeCallback = completeCallback;
+    _loading = true;
+    
+    if (_paths.empty())
+    {
+        _loading = false;
+        if (_completeCallback != nullptr)
+        {
+            _completeCallback();
+        }
+        return;
+    }
+    
+    // 已缓存的图片会在addImageAsync内部立即回调，完成回调中取消或重新开始时停止提交
+    TextureCache* textureCache = Director::getInstance()->getTextureCache();
+    for (const std::string& path : paths)
+    {
+        if (!_loading)
+        {
+            break;
+        }
+        textureCache->addImageAsync(path, [this](Texture2D* texture) {
+            this->onTextureLoaded(texture);
+        }, getCallbackKey(path));
+    }
+}
+
+void TexturePreloadManager::cancel()
+{
+    if (_loading)
+    {
+        TextureCache* textureCache = Director::getInstance()->getTextureCache();
+        for (const std::string& path : _paths)
+        {
+            textureCache->unbindImageAsync(getCallbackKey(path));
+        }
+    }
+    _loading = false;
+    _progressCallback = nullptr;
+    _completeCallback = nullptr;
+}
+
+void TexturePreloadManager::onTextureLoaded(Texture2D* texture)
+{
+    if (!_loading)
+    {
+        return;
+    }
+    
+    ++_loadedCount;
+    int totalCount = (int)_paths.size();
+    if (_progressCallback != nullptr)
+    {
+        _progressCallback(_loadedCount, totalCount);
+    }
+    
+    if (_loadedCount >= totalCount)
+    {
+        // 先复位状态，完成回调中可以开始新的加载或销毁本管理器
+        _loading = false;
+        CompleteCallback completeCallback = _completeCallback;
+        _progressCallback = nullptr;
+        _completeCallback = nullptr;
+        if (completeCallback != nullptr)
+        {
+            completeCallback();
+        }
+    }
+}
+
+std::string TexturePreloadManager::getCallbackKey(const std::string& path) const
+{
+    return "TexturePreloadManager:" + path;
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __TEXTURE_PRELOAD_MANAGER_H__
+#define __TEXTURE_PRELOAD_MANAGER_H__
+
+#include "cocos2d.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 纹理预加载管理器
+ * 按清单逐个调用TextureCache::addImageAsync，图片在加载线程解码，纹理在主线程创建并放入纹理缓存
+ * 每完成一张（包括加载失败的）回调一次进度，全部完成后回调一次完成
+ * 禁止实现为单例模式，作为controller的成员变量
+ */
+class TexturePreloadManager
+{
+public:
+    typedef std::function<void(int loadedCount, int totalCount)> ProgressCallback;
+    typedef std::function<void()> CompleteCallback;
+    
+    TexturePreloadManager();
+    virtual ~TexturePreloadManager();
+    
+    /**
+     * @brief 开始预加载（取消上一次未完成的加载）
+     * 已在纹理缓存中的图片在调用期间立即完成，清单全部已缓存或为空时完成回调在返回前调用
+     * @param paths 图片路径清单
+     * @param progressCallback 进度回调（可为nullptr）
+     * @param completeCallback 完成回调（可为nullptr）
+     */
+    void start(const std::vector<std::string>& paths, const ProgressCallback& progressCallback,
+               const CompleteCallback& completeCallback);
+    
+    /**
+     * @brief 取消未完成的加载，之后不再回调（已提交的图片仍会进入纹理缓存）
+     */
+    void cancel();
+    
+    /**
+     * @brief 是否正在加载
+     */
+    bool isLoading() const { return _loading; }
+    
+    int getLoadedCount() const { return _loadedCount; }
+    int getTotalCount() const { return (int)_paths.size(); }
+
+private:
+    /**
+     * @brief 单张图片加载完成（texture为nullptr表示加载失败）
+     */
+    void onTextureLoaded(cocos2d::Texture2D* texture);
+    
+    /**
+     * @brief 本管理器提交的异步加载使用的回调键，取消时不影响其他来源对同一图片的请求
+     */
+    std::string getCallbackKey(const std::string& path) const;
+    
+    std::vector<std::string> _paths;        // 当前清单
+    int _loadedCount;                       // 已完成数量
+    bool _loading;                          // 是否正在加载
+    ProgressCallback _progressCallback;     // 进度回调
+    CompleteCallback _completeCallback;     // 完成回调
+};
+
+#endif // __TEXTURE_PRELOAD_MANAGER_H__
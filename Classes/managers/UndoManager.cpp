@@ -22,12 +22,13 @@
  THE SOFTWARE.
  ****************************************************************************/
 
+
 #include "UndoManager.h"
 #include "../models/GameModel.h"
-#include "../utils/CommonUtils.h"
 
 UndoManager::UndoManager()
 : _gameModel(nullptr)
+, _cursor(0)
 {
 }
 
@@ -41,32 +42,107 @@ void UndoManager::init(GameModel* gameModel)
     _gameModel = gameModel;
 }
 
-void UndoManager::pushUndoRecord(UndoModel* undoModel)
+void UndoManager::pushUndoRecord(const UndoRecord& record)
 {
-    if (undoModel != nullptr)
+    // 新操作使重做记录失效，定长记录直接截断
+    _records.resize(_cursor);
+    _records.push_back(record);
+    _cursor = _records.size();
+}
+
+const UndoRecord* UndoManager::getUndoRecord() const
+{
+    if (_cursor == 0)
     {
-        _undoStack.push_back(undoModel);
+        return nullptr;
     }
+    return &_records[_cursor - 1];
 }
 
-UndoModel* UndoManager::popUndoRecord()
+const UndoRecord* UndoManager::getRedoRecord() const
 {
-    if (_undoStack.empty())
+    if (_cursor >= _records.size())
     {
         return nullptr;
     }
-    
-    UndoModel* undoModel = _undoStack.back();
-    _undoStack.pop_back();
-    return undoModel;
+    return &_records[_cursor];
+}
+
+void UndoManager::stepBack()
+{
+    if (_cursor > 0)
+    {
+        --_cursor;
+    }
+}
+
+void UndoManager::stepForward()
+{
+    if (_cursor < _records.size())
+    {
+        ++_cursor;
+    }
+}
+
+void UndoManager::assignRecords(const UndoRecord* records, size_t count)
+{
+    if (records == nullptr)
+    {
+        count = 0;
+    }
+    _records.assign(records, records + count);
+    _cursor = _records.size();
 }
 
 void UndoManager::clear()
 {
-    for (UndoModel* model : _undoStack)
+    _records.clear();
+    _cursor = 0;
+}
+
+bool UndoManager::applyRecord(GameModel* gameModel, const UndoRecord& record)
+{
+    if (gameModel == nullptr || gameModel->getBottomCardId() != record.replacedCardId)
+    {
+        return false;
+    }
+    
+    if (record.actionType == UndoActionType::ELIMINATE_CARD)
     {
-        delete model;
+        if (!gameModel->removeFromPlayField(record.cardId))
+        {
+            return false;
+        }
     }
-    _undoStack.clear();
+    else
+    {
+        const std::vector<int>& stackCardIds = gameModel->getStackCardIds();
+        if (stackCardIds.empty() || stackCardIds.back() != record.cardId)
+        {
+            return false;
+        }
+        gameModel->removeTopFromStack();
+    }
+    
+    gameModel->setBottomCardId(record.cardId);
+    return true;
 }
 
+bool UndoManager::revertRecord(GameModel* gameModel, const UndoRecord& record)
+{
+    if (gameModel == nullptr || gameModel->getBottomCardId() != record.cardId)
+    {
+        return false;
+    }
+    
+    gameModel->setBottomCardId(record.replacedCardId);
+    if (record.actionType == UndoActionType::ELIMINATE_CARD)
+    {
+        gameModel->insertToPlayField(record.playFieldIndex, record.cardId);
+    }
+    else
+    {
+        gameModel->addToStackTop(record.cardId);
+    }
+    return true;
+}
@@ -22,11 +22,12 @@
  THE SOFTWARE.
  ****************************************************************************/
 
+
 #ifndef __UNDO_MANAGER_H__
 #define __UNDO_MANAGER_H__
 
-#include "cocos2d.h"
-#include "../models/UndoModel.h"
+#include "../models/UndoRecord.h"
+#include <cstddef>
 #include <vector>
 
 // 前向声明
@@ -36,6 +37,7 @@ class GameModel;
  * @brief 撤销功能管理器
  * 管理游戏操作的撤销记录，可持有model数据并对model数据进行加工
  * 禁止实现为单例模式，作为controller的成员变量
+ * 记录以定长UndoRecord连续存放，游标之前为可撤销的步骤，之后为可重做的步骤
  */
 class UndoManager
 {
@@ -50,31 +52,82 @@ public:
     void init(GameModel* gameModel);
     
     /**
-     * @brief 添加撤销记录
-     * @param undoModel 撤销数据模型
+     * @brief 添加撤销记录，丢弃游标之后的重做记录
+     * @param record 撤销记录
+     */
+    void pushUndoRecord(const UndoRecord& record);
+    
+    /**
+     * @brief 获取下一步要撤销的记录（不移动游标）
+     * @return 撤销记录，如果没有可撤销的记录返回nullptr
      */
-    void pushUndoRecord(UndoModel* undoModel);
+    const UndoRecord* getUndoRecord() const;
     
     /**
-     * @brief 执行撤销操作
-     * @return 撤销数据模型，如果没有可撤销的记录返回nullptr
+     * @brief 获取下一步要重做的记录（不移动游标）
+     * @return 重做记录，如果没有可重做的记录返回nullptr
      */
-    UndoModel* popUndoRecord();
+    const UndoRecord* getRedoRecord() const;
+    
+    /**
+     * @brief 撤销/重做执行成功后移动游标
+     */
+    void stepBack();
+    void stepForward();
     
     /**
      * @brief 检查是否有可撤销的记录
      */
-    bool canUndo() const { return !_undoStack.empty(); }
+    bool canUndo() const { return _cursor > 0; }
+    
+    /**
+     * @brief 检查是否有可重做的记录
+     */
+    bool canRedo() const { return _cursor < _records.size(); }
+    
+    /**
+     * @brief 获取当前步数（游标位置）
+     */
+    size_t getMoveCount() const { return _cursor; }
+    
+    /**
+     * @brief 获取记录总数（包括可重做的记录）
+     */
+    size_t getRecordCount() const { return _records.size(); }
+    
+    /**
+     * @brief 获取所有记录（从旧到新）
+     */
+    const UndoRecord* getRecords() const { return _records.data(); }
+    
+    /**
+     * @brief 用给定记录替换全部记录，游标位于末尾（用于恢复快照）
+     * @param records 撤销记录（从旧到新）
+     * @param count 记录数量
+     */
+    void assignRecords(const UndoRecord* records, size_t count);
     
     /**
      * @brief 清空所有撤销记录
      */
     void clear();
+    
+    /**
+     * @brief 对模型正向执行一条记录
+     * @return 模型状态与记录不符时返回false，模型保持不变
+     */
+    static bool applyRecord(GameModel* gameModel, const UndoRecord& record);
+    
+    /**
+     * @brief 对模型撤销一条记录
+     * @return 模型状态与记录不符时返回false，模型保持不变
+     */
+    static bool revertRecord(GameModel* gameModel, const UndoRecord& record);
 
 private:
     GameModel* _gameModel;                      // 游戏模型指针
-    std::vector<UndoModel*> _undoStack;         // 撤销记录栈
+    std::vector<UndoRecord> _records;           // 撤销记录（从旧到新）
+    size_t _cursor;                             // 当前步数，[0, _cursor)可撤销，[_cursor, size)可重做
 };
 
 #endif // __UNDO_MANAGER_H__
-
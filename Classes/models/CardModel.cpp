@@ -23,6 +23,7 @@
  ****************************************************************************/
 
 #include "CardModel.h"
+#include <cstdlib>
 
 CardModel::CardModel()
 : _cardId(0)
@@ -53,7 +54,8 @@ int CardModel::getFaceValue() const
 
 bool CardModel::canMatchWith(const CardModel* other) const
 {
-    if (other == nullptr)
+    // 没有点数的卡牌（CFT_NONE）不与任何卡牌匹配，与GameModel::canCardsMatch一致
+    if (other == nullptr || _face == CFT_NONE || other->getFace() == CFT_NONE)
     {
         return false;
     }
@@ -77,6 +79,7 @@ bool CardModel::canMatchWith(const CardModel* other) const
     return false;
 }
 
+#ifndef GAME_HEADLESS
 cocos2d::ValueMap CardModel::toValueMap() const
 {
     cocos2d::ValueMap map;
@@ -101,4 +104,4 @@ bool CardModel::fromValueMap(const cocos2d::ValueMap& map)
     
     return true;
 }
-
+#endif
@@ -25,7 +25,9 @@
 #ifndef __CARD_MODEL_H__
 #define __CARD_MODEL_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
 #include "../configs/models/CardResConfig.h"
 
 /**
@@ -64,12 +66,13 @@ public:
     int getFaceValue() const;
     
     /**
-     * @brief 判断两张卡牌点数是否相差1
+     * @brief 判断两张卡牌点数是否相差1（K和A循环相邻）
      * @param other 另一张卡牌
-     * @return true表示点数差1，可以匹配
+     * @return true表示点数差1，可以匹配；任一张没有点数（CFT_NONE）时返回false
      */
     bool canMatchWith(const CardModel* other) const;
     
+#ifndef GAME_HEADLESS
     /**
      * @brief 序列化（用于存档）
      */
@@ -79,6 +82,7 @@ public:
      * @brief 反序列化（用于读档）
      */
     bool fromValueMap(const cocos2d::ValueMap& map);
+#endif
 
 private:
     int _cardId;            // 卡牌唯一ID
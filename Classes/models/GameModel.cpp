@@ -23,6 +23,8 @@
  ****************************************************************************/
 
 #include "GameModel.h"
+#include <algorithm>
+#include <cstdlib>
 
 GameModel::GameModel()
 : _levelId(0)
@@ -35,32 +37,225 @@ GameModel::~GameModel()
     clear();
 }
 
-CardModel* GameModel::getCardById(int cardId)
+const CardModel* GameModel::getCardById(int cardId) const
 {
-    auto it = _allCards.find(cardId);
-    if (it != _allCards.end())
+    if (hasCard(cardId))
     {
-        return it->second;
+        return &_cards[cardId];
     }
     return nullptr;
 }
 
-const CardModel* GameModel::getCardById(int cardId) const
+bool GameModel::canCardsMatch(int cardIdA, int cardIdB) const
 {
-    auto it = _allCards.find(cardId);
-    if (it != _allCards.end())
+    int faceA = getCardFace(cardIdA);
+    int faceB = getCardFace(cardIdB);
+    if (faceA == CFT_NONE || faceB == CFT_NONE)
     {
-        return it->second;
+        return false;
+    }
+    
+    // 点数差1即可匹配，K和A循环相邻
+    int diff = abs(faceA - faceB);
+    return diff == 1 || diff == CFT_NUM_CARD_FACE_TYPES - 1;
+}
+
+const std::vector<int>& GameModel::getPlayFieldCardsByFace(CardFaceType face) const
+{
+    static const std::vector<int> EMPTY_BUCKET;
+    if (face < 0 || face >= CFT_NUM_CARD_FACE_TYPES)
+    {
+        return EMPTY_BUCKET;
+    }
+    return _playFieldFaceBuckets[face];
+}
+
+int GameModel::getPlayFieldMatchCount(int cardId) const
+{
+    int face = getCardFace(cardId);
+    if (face == CFT_NONE)
+    {
+        return 0;
+    }
+    
+    // 相邻点数（K和A循环相邻）
+    int lowerFace = (face + CFT_NUM_CARD_FACE_TYPES - 1) % CFT_NUM_CARD_FACE_TYPES;
+    int upperFace = (face + 1) % CFT_NUM_CARD_FACE_TYPES;
+    return (int)(_playFieldFaceBuckets[lowerFace].size() + _playFieldFaceBuckets[upperFace].size());
+}
+
+void GameModel::collectPlayFieldMatches(int cardId, std::vector<int>& cardIds) const
+{
+    cardIds.clear();
+    int face = getCardFace(cardId);
+    if (face == CFT_NONE)
+    {
+        return;
+    }
+    
+    int lowerFace = (face + CFT_NUM_CARD_FACE_TYPES - 1) % CFT_NUM_CARD_FACE_TYPES;
+    int upperFace = (face + 1) % CFT_NUM_CARD_FACE_TYPES;
+    const std::vector<int>& lowerBucket = _playFieldFaceBuckets[lowerFace];
+    const std::vector<int>& upperBucket = _playFieldFaceBuckets[upperFace];
+    cardIds.insert(cardIds.end(), lowerBucket.begin(), lowerBucket.end());
+    cardIds.insert(cardIds.end(), upperBucket.begin(), upperBucket.end());
+}
+
+void GameModel::reserveCards(int maxCardId)
+{
+    if (maxCardId < 0)
+    {
+        return;
+    }
+    
+    size_t capacity = (size_t)maxCardId + 1;
+    _cards.reserve(capacity);
+    _cardFaces.reserve(capacity);
+    _cardSuits.reserve(capacity);
+    _cardZones.reserve(capacity);
+    _faceBucketSlots.reserve(capacity);
+    _coveringCounts.reserve(capacity);
+    _firstCoveredEdges.reserve(capacity);
+    _firstCoveringEdges.reserve(capacity);
+    _cardIds.reserve(capacity);
+}
+
+bool GameModel::addCard(int cardId, CardSuitType suit, CardFaceType face)
+{
+    // 点数超出范围会越界访问按点数分桶的索引
+    if (cardId < 0 || hasCard(cardId)
+        || suit < CST_NONE || suit >= CST_NUM_CARD_SUIT_TYPES
+        || face < CFT_NONE || face >= CFT_NUM_CARD_FACE_TYPES)
+    {
+        return false;
+    }
+    
+    if (cardId >= (int)_cards.size())
+    {
+        // 空位的cardId为-1，点数、花色、区域均为NONE
+        size_t size = (size_t)cardId + 1;
+        _cards.resize(size, CardModel(-1, CST_NONE, CFT_NONE));
+        _cardFaces.resize(size, (signed char)CFT_NONE);
+        _cardSuits.resize(size, (signed char)CST_NONE);
+        _cardZones.resize(size, CardZone::NONE);
+        _faceBucketSlots.resize(size, -1);
+        _coveringCounts.resize(size, 0);
+        _firstCoveredEdges.resize(size, -1);
+        _firstCoveringEdges.resize(size, -1);
+    }
+    
+    _cards[cardId] = CardModel(cardId, suit, face);
+    _cardFaces[cardId] = (signed char)face;
+    _cardSuits[cardId] = (signed char)suit;
+    _cardZones[cardId] = CardZone::NONE;
+    _faceBucketSlots[cardId] = -1;
+    _coveringCounts[cardId] = 0;
+    _firstCoveredEdges[cardId] = -1;
+    _firstCoveringEdges[cardId] = -1;
+    _cardIds.push_back(cardId);
+    return true;
+}
+
+bool GameModel::addCover(int coverCardId, int coveredCardId)
+{
+    if (!hasCard(coverCardId) || !hasCard(coveredCardId) || coverCardId == coveredCardId)
+    {
+        return false;
+    }
+    
+    // 两张卡牌各自的关系链表头插
+    int edge = (int)_covers.size();
+    CardCover cover = { coverCardId, coveredCardId };
+    _covers.push_back(cover);
+    _nextCoveredEdges.push_back(_firstCoveredEdges[coverCardId]);
+    _firstCoveredEdges[coverCardId] = edge;
+    _nextCoveringEdges.push_back(_firstCoveringEdges[coveredCardId]);
+    _firstCoveringEdges[coveredCardId] = edge;
+    
+    if (_cardZones[coverCardId] == CardZone::PLAY_FIELD && _coveringCounts[coveredCardId]++ == 0)
+    {
+        eraseFromFaceBucket(coveredCardId);
+    }
+    return true;
+}
+
+void GameModel::collectCoveredCards(int cardId, std::vector<int>& cardIds) const
+{
+    cardIds.clear();
+    if (!isValidSlot(cardId))
+    {
+        return;
+    }
+    for (int edge = _firstCoveredEdges[cardId]; edge >= 0; edge = _nextCoveredEdges[edge])
+    {
+        cardIds.push_back(_covers[edge].coveredCardId);
+    }
+}
+
+void GameModel::collectCoveringCards(int cardId, std::vector<int>& cardIds) const
+{
+    cardIds.clear();
+    if (!isValidSlot(cardId))
+    {
+        return;
+    }
+    for (int edge = _firstCoveringEdges[cardId]; edge >= 0; edge = _nextCoveringEdges[edge])
+    {
+        cardIds.push_back(_covers[edge].coverCardId);
     }
-    return nullptr;
 }
 
 void GameModel::addCard(CardModel* card)
 {
     if (card != nullptr)
     {
-        _allCards[card->getCardId()] = card;
+        addCard(card->getCardId(), card->getSuit(), card->getFace());
+        delete card;
+    }
+}
+
+void GameModel::setBottomCardId(int cardId)
+{
+    if (_bottomCardId != cardId && getCardZone(_bottomCardId) == CardZone::BOTTOM)
+    {
+        setCardZone(_bottomCardId, CardZone::DISCARD);
+    }
+    _bottomCardId = cardId;
+    setCardZone(cardId, CardZone::BOTTOM);
+}
+
+void GameModel::discardCard(int cardId)
+{
+    if (getCardZone(cardId) == CardZone::NONE)
+    {
+        setCardZone(cardId, CardZone::DISCARD);
+    }
+}
+
+void GameModel::addToPlayField(int cardId)
+{
+    _playFieldCardIds.push_back(cardId);
+    setCardZone(cardId, CardZone::PLAY_FIELD, (int)_playFieldCardIds.size() - 1);
+}
+
+void GameModel::insertToPlayField(int index, int cardId)
+{
+    if (index < 0 || index > (int)_playFieldCardIds.size())
+    {
+        index = (int)_playFieldCardIds.size();
+    }
+    _playFieldCardIds.insert(_playFieldCardIds.begin() + index, cardId);
+    setCardZone(cardId, CardZone::PLAY_FIELD, index);
+}
+
+int GameModel::getPlayFieldIndex(int cardId) const
+{
+    auto it = std::find(_playFieldCardIds.begin(), _playFieldCardIds.end(), cardId);
+    if (it == _playFieldCardIds.end())
+    {
+        return -1;
     }
+    return (int)(it - _playFieldCardIds.begin());
 }
 
 bool GameModel::removeFromPlayField(int cardId)
@@ -69,6 +264,7 @@ bool GameModel::removeFromPlayField(int cardId)
     if (it != _playFieldCardIds.end())
     {
         _playFieldCardIds.erase(it);
+        setCardZone(cardId, CardZone::NONE);
         return true;
     }
     return false;
@@ -82,23 +278,170 @@ int GameModel::removeTopFromStack()
     }
     int topCardId = _stackCardIds.back();
     _stackCardIds.pop_back();
+    setCardZone(topCardId, CardZone::NONE);
     return topCardId;
 }
 
 void GameModel::addToStackTop(int cardId)
 {
     _stackCardIds.push_back(cardId);
+    setCardZone(cardId, CardZone::STACK, (int)_stackCardIds.size() - 1);
+}
+
+void GameModel::setZoneChangeTracking(bool enabled)
+{
+    if (!enabled && _zoneChangeLog.tracking)
+    {
+        _zoneChangeLog.discard();
+        _zoneChangeLog.changes.shrink_to_fit();
+    }
+    _zoneChangeLog.tracking = enabled;
+}
+
+int GameModel::addZoneChangeReader() const
+{
+    _zoneChangeLog.readers.push_back(getZoneChangeEnd());
+    return (int)_zoneChangeLog.readers.size() - 1;
+}
+
+void GameModel::acknowledgeZoneChanges(int readerId, size_t sequence) const
+{
+    ZoneChangeLog& log = _zoneChangeLog;
+    if (readerId < 0 || readerId >= (int)log.readers.size())
+    {
+        return;
+    }
+    log.readers[readerId] = sequence < getZoneChangeEnd() ? sequence : getZoneChangeEnd();
+    
+    // 丢弃所有读者都确认过的前缀；clear之前的确认位置落在base之前，不影响丢弃
+    size_t oldest = getZoneChangeEnd();
+    for (size_t readerSequence : log.readers)
+    {
+        oldest = readerSequence < oldest ? readerSequence : oldest;
+    }
+    if (oldest <= log.base)
+    {
+        return;
+    }
+    if (oldest == getZoneChangeEnd())
+    {
+        log.changes.clear();
+    }
+    else
+    {
+        log.changes.erase(log.changes.begin(), log.changes.begin() + (oldest - log.base));
+    }
+    log.base = oldest;
+}
+
+void GameModel::setCardZone(int cardId, CardZone zone, int zoneIndex)
+{
+    if (!hasCard(cardId))
+    {
+        return;
+    }
+    
+    CardZone oldZone = _cardZones[cardId];
+    _cardZones[cardId] = zone;
+    if (_zoneChangeLog.tracking && oldZone != zone)
+    {
+        CardZoneChange change = { cardId, zoneIndex, oldZone, zone };
+        _zoneChangeLog.changes.push_back(change);
+    }
+    
+    if ((oldZone == CardZone::PLAY_FIELD) == (zone == CardZone::PLAY_FIELD))
+    {
+        return;
+    }
+    
+    if (zone == CardZone::PLAY_FIELD)
+    {
+        // 进入主牌堆：遮挡下层卡牌，自身没有被遮挡时加入点数桶
+        for (int edge = _firstCoveredEdges[cardId]; edge >= 0; edge = _nextCoveredEdges[edge])
+        {
+            int coveredCardId = _covers[edge].coveredCardId;
+            if (_coveringCounts[coveredCardId]++ == 0)
+            {
+                eraseFromFaceBucket(coveredCardId);
+            }
+        }
+        if (_coveringCounts[cardId] == 0)
+        {
+            insertIntoFaceBucket(cardId);
+        }
+    }
+    else
+    {
+        // 离开主牌堆：下层卡牌的上层全部离开后重新可点击
+        eraseFromFaceBucket(cardId);
+        for (int edge = _firstCoveredEdges[cardId]; edge >= 0; edge = _nextCoveredEdges[edge])
+        {
+            int coveredCardId = _covers[edge].coveredCardId;
+            if (--_coveringCounts[coveredCardId] == 0 && _cardZones[coveredCardId] == CardZone::PLAY_FIELD)
+            {
+                insertIntoFaceBucket(coveredCardId);
+            }
+        }
+    }
+}
+
+void GameModel::insertIntoFaceBucket(int cardId)
+{
+    int face = _cardFaces[cardId];
+    if (face == CFT_NONE || _faceBucketSlots[cardId] >= 0)
+    {
+        return;
+    }
+    
+    std::vector<int>& bucket = _playFieldFaceBuckets[face];
+    _faceBucketSlots[cardId] = (int)bucket.size();
+    bucket.push_back(cardId);
+}
+
+void GameModel::eraseFromFaceBucket(int cardId)
+{
+    int slot = _faceBucketSlots[cardId];
+    if (slot < 0)
+    {
+        return;
+    }
+    
+    // 与桶尾交换后删除
+    std::vector<int>& bucket = _playFieldFaceBuckets[_cardFaces[cardId]];
+    int lastCardId = bucket.back();
+    bucket[slot] = lastCardId;
+    _faceBucketSlots[lastCardId] = slot;
+    bucket.pop_back();
+    _faceBucketSlots[cardId] = -1;
+}
+
+void GameModel::rebuildCardZones()
+{
+    for (int cardId : _cardIds)
+    {
+        setCardZone(cardId, CardZone::NONE);
+    }
+    for (size_t i = 0; i < _playFieldCardIds.size(); ++i)
+    {
+        setCardZone(_playFieldCardIds[i], CardZone::PLAY_FIELD, (int)i);
+    }
+    for (size_t i = 0; i < _stackCardIds.size(); ++i)
+    {
+        setCardZone(_stackCardIds[i], CardZone::STACK, (int)i);
+    }
+    setCardZone(_bottomCardId, CardZone::BOTTOM);
 }
 
+#ifndef GAME_HEADLESS
 cocos2d::ValueMap GameModel::toValueMap() const
 {
     cocos2d::ValueMap map;
     map["levelId"] = _levelId;
     
     cocos2d::ValueMap cardsMap;
-    for (auto& pair : _allCards)
+    for (int cardId : _cardIds)
     {
-        cardsMap[std::to_string(pair.first)] = pair.second->toValueMap();
+        cardsMap[std::to_string(cardId)] = _cards[cardId].toValueMap();
     }
     map["allCards"] = cardsMap;
     
@@ -117,6 +460,15 @@ cocos2d::ValueMap GameModel::toValueMap() const
     map["stackCardIds"] = stackVec;
     map["bottomCardId"] = _bottomCardId;
     
+    // 遮挡关系按（上层ID, 下层ID）依次展开
+    cocos2d::ValueVector coverVec;
+    for (const CardCover& cover : _covers)
+    {
+        coverVec.push_back(cocos2d::Value(cover.coverCardId));
+        coverVec.push_back(cocos2d::Value(cover.coveredCardId));
+    }
+    map["covers"] = coverVec;
+    
     return map;
 }
 
@@ -136,14 +488,10 @@ bool GameModel::fromValueMap(const cocos2d::ValueMap& map)
         cocos2d::ValueMap cardsMap = map.at("allCards").asValueMap();
         for (auto& pair : cardsMap)
         {
-            CardModel* card = new CardModel();
-            if (card->fromValueMap(pair.second.asValueMap()))
-            {
-                _allCards[card->getCardId()] = card;
-            }
-            else
+            CardModel card;
+            if (card.fromValueMap(pair.second.asValueMap()))
             {
-                delete card;
+                addCard(card.getCardId(), card.getSuit(), card.getFace());
             }
         }
     }
@@ -171,18 +519,41 @@ bool GameModel::fromValueMap(const cocos2d::ValueMap& map)
         _bottomCardId = map.at("bottomCardId").asInt();
     }
     
+    rebuildCardZones();
+    
+    if (map.find("covers") != map.end())
+    {
+        cocos2d::ValueVector vec = map.at("covers").asValueVector();
+        for (size_t i = 0; i + 1 < vec.size(); i += 2)
+        {
+            addCover(vec[i].asInt(), vec[i + 1].asInt());
+        }
+    }
     return true;
 }
+#endif
 
 void GameModel::clear()
 {
-    for (auto& pair : _allCards)
+    _cards.clear();
+    _cardFaces.clear();
+    _cardSuits.clear();
+    _cardZones.clear();
+    _faceBucketSlots.clear();
+    _coveringCounts.clear();
+    _covers.clear();
+    _firstCoveredEdges.clear();
+    _firstCoveringEdges.clear();
+    _nextCoveredEdges.clear();
+    _nextCoveringEdges.clear();
+    for (std::vector<int>& bucket : _playFieldFaceBuckets)
     {
-        delete pair.second;
+        bucket.clear();
     }
-    _allCards.clear();
+    _cardIds.clear();
     _playFieldCardIds.clear();
     _stackCardIds.clear();
     _bottomCardId = 0;
+    _zoneChangeLog.discard();
 }
 
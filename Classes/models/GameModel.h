@@ -25,14 +25,53 @@
 #ifndef __GAME_MODEL_H__
 #define __GAME_MODEL_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
 #include "CardModel.h"
 #include <vector>
-#include <map>
+
+/**
+ * @brief 卡牌所在区域
+ */
+enum class CardZone : unsigned char
+{
+    NONE,           // 未放置（刚加入或正在移动）
+    PLAY_FIELD,     // 主牌区
+    STACK,          // 备用牌堆
+    BOTTOM,         // 底牌
+    DISCARD         // 已被新底牌覆盖
+};
+
+/**
+ * @brief 一次卡牌区域变化（视图按变化增量更新，不再逐张比对牌堆）
+ */
+struct CardZoneChange
+{
+    int cardId;             // 卡牌ID
+    int zoneIndex;          // 进入主牌堆/备用牌堆时的位置，其他区域为-1
+    CardZone fromZone;      // 原区域
+    CardZone toZone;        // 新区域
+};
+
+/**
+ * @brief 主牌区的一条遮挡关系：上层卡牌在主牌区时，下层卡牌不可点击
+ */
+struct CardCover
+{
+    int coverCardId;        // 上层卡牌ID
+    int coveredCardId;      // 被遮挡的卡牌ID
+};
 
 /**
  * @brief 游戏数据模型
  * 存储游戏运行时的所有动态数据
+ * 卡牌按ID稠密存储（ID即下标），点数、花色、区域各自连续存放，不再逐张分配内存
+ * 主牌堆另按点数分桶，增量维护，匹配查询与主牌堆大小无关
+ * 主牌区卡牌之间可有遮挡关系（有向无环图），每张牌记录仍在主牌区的上层卡牌数，
+ * 卡牌进出主牌区时只更新它遮挡的卡牌（O(出度)），点数桶中只保留未被遮挡的卡牌
+ * 开启区域变化记录后，每次区域变化追加到变化列表，各视图记住已处理的位置，只处理新增的变化，
+ * 处理后向模型确认，所有读者都确认过的变化被丢弃；复制牌局时不复制变化记录和读者
  */
 class GameModel
 {
@@ -47,30 +86,128 @@ public:
     void setLevelId(int levelId) { _levelId = levelId; }
     
     /**
-     * @brief 获取所有卡牌数据（通过ID访问）
+     * @brief 获取所有卡牌ID（按加入顺序）
      */
-    std::map<int, CardModel*>& getAllCards() { return _allCards; }
-    const std::map<int, CardModel*>& getAllCards() const { return _allCards; }
+    const std::vector<int>& getCardIds() const { return _cardIds; }
+    
+    /**
+     * @brief 获取卡牌数量
+     */
+    int getCardCount() const { return (int)_cardIds.size(); }
+    
+    /**
+     * @brief 是否存在该ID的卡牌
+     */
+    bool hasCard(int cardId) const
+    {
+        return cardId >= 0 && cardId < (int)_cards.size() && _cards[cardId].getCardId() == cardId;
+    }
     
     /**
      * @brief 根据ID获取卡牌
+     * 返回的指针指向稠密存储，在下一次addCard或clear之前有效；
+     * 只读访问，点数、花色、区域同时保存在按ID索引的数组中，不能通过CardModel修改
      */
-    CardModel* getCardById(int cardId);
     const CardModel* getCardById(int cardId) const;
     
+    /**
+     * @brief 根据ID获取点数、花色、区域（不存在时返回CFT_NONE / CST_NONE / CardZone::NONE）
+     */
+    CardFaceType getCardFace(int cardId) const { return isValidSlot(cardId) ? (CardFaceType)_cardFaces[cardId] : CFT_NONE; }
+    CardSuitType getCardSuit(int cardId) const { return isValidSlot(cardId) ? (CardSuitType)_cardSuits[cardId] : CST_NONE; }
+    CardZone getCardZone(int cardId) const { return isValidSlot(cardId) ? _cardZones[cardId] : CardZone::NONE; }
+    
+    /**
+     * @brief 判断两张卡牌点数是否相差1（K和A循环相邻），规则与CardModel::canMatchWith一致（卡牌不存在或没有点数时返回false）
+     */
+    bool canCardsMatch(int cardIdA, int cardIdB) const;
+    
+    /**
+     * @brief 获取主牌堆中某点数未被遮挡的卡牌（按点数分桶，随主牌堆增删和遮挡变化增量维护，桶内顺序不固定）
+     * @param face 点数
+     */
+    const std::vector<int>& getPlayFieldCardsByFace(CardFaceType face) const;
+    
+    /**
+     * @brief 主牌堆中未被遮挡、可与该卡牌匹配的卡牌数量（O(1)）
+     * @param cardId 卡牌ID（通常为底牌）
+     */
+    int getPlayFieldMatchCount(int cardId) const;
+    
+    /**
+     * @brief 主牌堆中是否有未被遮挡、可与底牌匹配的卡牌（O(1)）
+     */
+    bool hasPlayFieldMatch() const { return getPlayFieldMatchCount(_bottomCardId) > 0; }
+    
+    /**
+     * @brief 收集主牌堆中未被遮挡、可与该卡牌匹配的卡牌ID，耗时与结果数量成正比
+     * @param cardId 卡牌ID（通常为底牌）
+     * @param cardIds 输出（先清空）
+     */
+    void collectPlayFieldMatches(int cardId, std::vector<int>& cardIds) const;
+    
+    /**
+     * @brief 卡牌是否在主牌堆中且没有被遮挡（可点击）
+     */
+    bool isCardExposed(int cardId) const { return isValidSlot(cardId) && _faceBucketSlots[cardId] >= 0; }
+    
+    /**
+     * @brief 仍在主牌堆中、遮挡该卡牌的卡牌数量
+     */
+    int getCoveringCount(int cardId) const { return isValidSlot(cardId) ? _coveringCounts[cardId] : 0; }
+    
+    /**
+     * @brief 添加遮挡关系（可在卡牌进入主牌堆之前或之后添加，调用方保证不成环）
+     * @param coverCardId 上层卡牌ID
+     * @param coveredCardId 被遮挡的卡牌ID
+     * @return 卡牌不存在或两者相同时返回false
+     */
+    bool addCover(int coverCardId, int coveredCardId);
+    
+    /**
+     * @brief 获取所有遮挡关系（按添加顺序）
+     */
+    const std::vector<CardCover>& getCovers() const { return _covers; }
+    
+    /**
+     * @brief 收集该卡牌遮挡的卡牌ID（无论是否还在主牌堆）
+     * @param cardIds 输出（先清空）
+     */
+    void collectCoveredCards(int cardId, std::vector<int>& cardIds) const;
+    
+    /**
+     * @brief 收集遮挡该卡牌的卡牌ID（无论是否还在主牌堆）
+     * @param cardIds 输出（先清空）
+     */
+    void collectCoveringCards(int cardId, std::vector<int>& cardIds) const;
+    
+    /**
+     * @brief 预留卡牌存储空间，避免加入卡牌时重新分配
+     * @param maxCardId 最大卡牌ID
+     */
+    void reserveCards(int maxCardId);
+    
     /**
      * @brief 添加卡牌
+     * @return ID无效或已存在、花色或点数超出枚举范围时返回false
+     */
+    bool addCard(int cardId, CardSuitType suit, CardFaceType face);
+    
+    /**
+     * @brief 添加卡牌（兼容旧接口，复制数据后释放card）
      */
     void addCard(CardModel* card);
     
     /**
      * @brief 获取主牌堆的卡牌ID列表
+     * 直接修改列表不会更新卡牌区域，应使用addToPlayField / removeFromPlayField
      */
     std::vector<int>& getPlayFieldCardIds() { return _playFieldCardIds; }
     const std::vector<int>& getPlayFieldCardIds() const { return _playFieldCardIds; }
     
     /**
      * @brief 获取备用牌堆的卡牌ID列表（从底部到顶部）
+     * 直接修改列表不会更新卡牌区域，应使用addToStackTop / removeTopFromStack
      */
     std::vector<int>& getStackCardIds() { return _stackCardIds; }
     const std::vector<int>& getStackCardIds() const { return _stackCardIds; }
@@ -79,7 +216,35 @@ public:
      * @brief 获取底牌ID（只有一张）
      */
     int getBottomCardId() const { return _bottomCardId; }
-    void setBottomCardId(int cardId) { _bottomCardId = cardId; }
+    
+    /**
+     * @brief 设置底牌，原底牌标记为已覆盖
+     */
+    void setBottomCardId(int cardId);
+    
+    /**
+     * @brief 将不在任何牌堆中的卡牌标记为已覆盖（用于恢复存档）
+     */
+    void discardCard(int cardId);
+    
+    /**
+     * @brief 将卡牌添加到主牌堆末尾
+     * @param cardId 卡牌ID
+     */
+    void addToPlayField(int cardId);
+    
+    /**
+     * @brief 将卡牌插入主牌堆指定位置（用于撤销时恢复原顺序）
+     * @param index 插入位置，超出范围时添加到末尾
+     * @param cardId 卡牌ID
+     */
+    void insertToPlayField(int index, int cardId);
+    
+    /**
+     * @brief 获取卡牌在主牌堆中的位置
+     * @return 位置下标，不在主牌堆中返回-1
+     */
+    int getPlayFieldIndex(int cardId) const;
     
     /**
      * @brief 从主牌堆移除卡牌
@@ -100,6 +265,40 @@ public:
      */
     void addToStackTop(int cardId);
     
+    /**
+     * @brief 开启/关闭区域变化记录（默认关闭，无界面模拟和求解不需要；关闭时清空已有记录）
+     */
+    void setZoneChangeTracking(bool enabled);
+    bool isZoneChangeTracking() const { return _zoneChangeLog.tracking; }
+    
+    /**
+     * @brief 登记一个区域变化读者，返回读者ID，从当前最新的变化开始读
+     * 变化只保留到最慢的读者确认过的位置；读者与牌局同生命周期，牌局销毁时一并释放
+     */
+    int addZoneChangeReader() const;
+    
+    /**
+     * @brief 读者确认已处理到sequence之前的所有变化，所有读者都确认过的变化从列表中丢弃
+     */
+    void acknowledgeZoneChanges(int readerId, size_t sequence) const;
+    
+    /**
+     * @brief 仍保留的区域变化序号范围[begin, end)（按发生顺序编号，clear后继续递增）
+     */
+    size_t getZoneChangeBegin() const { return _zoneChangeLog.base; }
+    size_t getZoneChangeEnd() const { return _zoneChangeLog.base + _zoneChangeLog.changes.size(); }
+    
+    /**
+     * @brief 按序号获取区域变化，sequence必须在[getZoneChangeBegin(), getZoneChangeEnd())内
+     */
+    const CardZoneChange& getZoneChange(size_t sequence) const { return _zoneChangeLog.changes[sequence - _zoneChangeLog.base]; }
+    
+    /**
+     * @brief 变化列表的代数，clear或关闭记录时加1，视图据此判断已处理的位置是否仍然有效
+     */
+    unsigned int getZoneChangeEpoch() const { return _zoneChangeLog.epoch; }
+    
+#ifndef GAME_HEADLESS
     /**
      * @brief 序列化
      */
@@ -109,18 +308,82 @@ public:
      * @brief 反序列化
      */
     bool fromValueMap(const cocos2d::ValueMap& map);
+#endif
     
     /**
      * @brief 清理所有数据
      */
     void clear();
 
+private:
+    /**
+     * @brief 根据主牌堆、备用牌堆、底牌重建所有卡牌的区域
+     */
+    void rebuildCardZones();
+    
+    /**
+     * @brief 下标是否在存储范围内（空位的点数、花色、区域均为NONE，可直接读取）
+     */
+    bool isValidSlot(int cardId) const { return cardId >= 0 && cardId < (int)_cardZones.size(); }
+    
+    /**
+     * @brief 卡牌加入/移出点数桶（桶中只有在主牌堆且未被遮挡的卡牌）
+     */
+    void insertIntoFaceBucket(int cardId);
+    void eraseFromFaceBucket(int cardId);
+    
+    /**
+     * @brief 设置卡牌区域，进出主牌堆时同步更新遮挡计数和点数桶，开启记录时追加区域变化
+     * @param zoneIndex 进入主牌堆/备用牌堆时的位置
+     */
+    void setCardZone(int cardId, CardZone zone, int zoneIndex = -1);
+    
+    /**
+     * @brief 区域变化记录，属于模型实例本身（读者登记在这个实例上）
+     * 复制得到的牌局不记录变化、没有读者；赋值时保留自己的读者和开关，丢弃已有变化并增加代数
+     */
+    struct ZoneChangeLog
+    {
+        bool tracking;                          // 是否记录区域变化
+        unsigned int epoch;                     // 变化列表代数
+        size_t base;                            // changes[0]的序号
+        std::vector<CardZoneChange> changes;    // 尚未被所有读者确认的区域变化（按发生顺序）
+        std::vector<size_t> readers;            // 各读者已确认的序号（下标为读者ID）
+        
+        ZoneChangeLog() : tracking(false), epoch(0), base(0) {}
+        ZoneChangeLog(const ZoneChangeLog&) : ZoneChangeLog() {}
+        ZoneChangeLog& operator=(const ZoneChangeLog&) { discard(); return *this; }
+        
+        /**
+         * @brief 丢弃所有变化，序号继续递增
+         */
+        void discard()
+        {
+            base += changes.size();
+            changes.clear();
+            ++epoch;
+        }
+    };
+
 private:
     int _levelId;
-    std::map<int, CardModel*> _allCards;        // 所有卡牌（cardId -> CardModel）
+    std::vector<CardModel> _cards;              // 所有卡牌（下标为cardId，空位的cardId为-1）
+    std::vector<signed char> _cardFaces;        // 点数（下标为cardId）
+    std::vector<signed char> _cardSuits;        // 花色（下标为cardId）
+    std::vector<CardZone> _cardZones;           // 所在区域（下标为cardId）
+    std::vector<int> _cardIds;                  // 所有卡牌ID（按加入顺序）
+    std::vector<int> _faceBucketSlots;          // 在点数桶中的位置（下标为cardId，不在主牌堆为-1）
+    std::vector<int> _playFieldFaceBuckets[CFT_NUM_CARD_FACE_TYPES];  // 主牌堆按点数分桶的未被遮挡卡牌ID
+    std::vector<int> _coveringCounts;           // 仍在主牌堆中的上层卡牌数（下标为cardId）
+    std::vector<CardCover> _covers;             // 遮挡关系（按添加顺序）
+    std::vector<int> _firstCoveredEdges;        // 该卡牌遮挡的第一条关系（下标为cardId，-1表示没有）
+    std::vector<int> _firstCoveringEdges;       // 遮挡该卡牌的第一条关系（下标为cardId，-1表示没有）
+    std::vector<int> _nextCoveredEdges;         // 同一上层卡牌的下一条关系（下标为关系下标）
+    std::vector<int> _nextCoveringEdges;        // 同一被遮挡卡牌的下一条关系（下标为关系下标）
     std::vector<int> _playFieldCardIds;         // 主牌堆卡牌ID列表
     std::vector<int> _stackCardIds;            // 备用牌堆卡牌ID列表（从底部到顶部）
     int _bottomCardId;                          // 底牌ID（只有一张）
+    mutable ZoneChangeLog _zoneChangeLog;       // 区域变化记录（读者确认只改变记录，不改变牌局）
 };
 
 #endif // __GAME_MODEL_H__
@@ -0,0 +1,190 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "MoveLog.h"
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief 文件头（24字节）
+     */
+    struct MoveLogHeader
+    {
+        uint32_t magic;             // MoveLog::MAGIC
+        uint16_t version;           // MoveLog::VERSION
+        uint16_t headerSize;        // 文件头字节数
+        int32_t levelId;            // 关卡ID
+        uint32_t entryCount;        // 操作数量
+        uint64_t seed;              // 发牌种子
+    };
+    
+    static_assert(sizeof(MoveLogHeader) == MoveLog::HEADER_SIZE, "move log header layout changed");
+    
+    inline uint64_t encodeEntry(const MoveLogEntry& entry)
+    {
+        uint64_t cardId = (entry.action == MoveLogAction::UNDO || entry.action == MoveLogAction::REDO) ? 0 : (uint32_t)entry.cardId;
+        return (cardId << 2) | (uint64_t)entry.action;
+    }
+    
+    inline size_t getVarintSize(uint64_t value)
+    {
+        size_t size = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+}
+
+MoveLog::MoveLog()
+: _levelId(0)
+, _seed(0)
+{
+}
+
+void MoveLog::reset(int levelId, uint64_t seed)
+{
+    _levelId = levelId;
+    _seed = seed;
+    _entries.clear();
+}
+
+void MoveLog::append(MoveLogAction action, int cardId)
+{
+    if (action == MoveLogAction::UNDO || action == MoveLogAction::REDO)
+    {
+        cardId = 0;
+    }
+    _entries.push_back({ action, cardId });
+}
+
+size_t MoveLog::getEncodedSize() const
+{
+    size_t size = HEADER_SIZE;
+    for (const MoveLogEntry& entry : _entries)
+    {
+        size += getVarintSize(encodeEntry(entry));
+    }
+    return size;
+}
+
+size_t MoveLog::write(void* buffer, size_t capacity) const
+{
+    size_t size = getEncodedSize();
+    if (buffer == nullptr || capacity < size)
+    {
+        return 0;
+    }
+    
+    MoveLogHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.headerSize = HEADER_SIZE;
+    header.levelId = _levelId;
+    header.entryCount = (uint32_t)_entries.size();
+    header.seed = _seed;
+    
+    unsigned char* output = (unsigned char*)buffer;
+    memcpy(output, &header, sizeof(header));
+    output += sizeof(header);
+    for (const MoveLogEntry& entry : _entries)
+    {
+        uint64_t value = encodeEntry(entry);
+        while (value >= 0x80)
+        {
+            *output++ = (unsigned char)(value | 0x80);
+            value >>= 7;
+        }
+        *output++ = (unsigned char)value;
+    }
+    return size;
+}
+
+bool MoveLog::read(const void* buffer, size_t size)
+{
+    reset(0, 0);
+    if (buffer == nullptr || size < HEADER_SIZE)
+    {
+        return false;
+    }
+    
+    MoveLogHeader header;
+    memcpy(&header, buffer, sizeof(header));
+    // 每条操作至少1字节，据此限制操作数量，避免恶意数据导致超大分配
+    if (header.magic != MAGIC || header.version != VERSION || header.headerSize != HEADER_SIZE
+        || header.entryCount > size - HEADER_SIZE)
+    {
+        return false;
+    }
+    
+    const unsigned char* input = (const unsigned char*)buffer + HEADER_SIZE;
+    const unsigned char* end = (const unsigned char*)buffer + size;
+    _entries.reserve(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i)
+    {
+        // 最多5字节（卡牌ID为31位非负整数，加2位操作类型）
+        uint64_t value = 0;
+        int shift = 0;
+        while (true)
+        {
+            if (input == end || shift > 28)
+            {
+                reset(0, 0);
+                return false;
+            }
+            unsigned char byte = *input++;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            shift += 7;
+            if ((byte & 0x80) == 0)
+            {
+                break;
+            }
+        }
+        
+        MoveLogAction action = (MoveLogAction)(value & 3);
+        uint64_t cardId = value >> 2;
+        bool isTap = (action == MoveLogAction::TAP_PLAY_FIELD || action == MoveLogAction::TAP_STACK);
+        if (cardId > 0x7FFFFFFF || (!isTap && cardId != 0))
+        {
+            reset(0, 0);
+            return false;
+        }
+        _entries.push_back({ action, (int32_t)cardId });
+    }
+    
+    // 不允许多余的尾部数据
+    if (input != end)
+    {
+        reset(0, 0);
+        return false;
+    }
+    
+    _levelId = header.levelId;
+    _seed = header.seed;
+    return true;
+}
@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __MOVE_LOG_H__
+#define __MOVE_LOG_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 操作记录中的操作类型（与编码的低2位一致，不可修改取值）
+ */
+enum class MoveLogAction : uint8_t
+{
+    TAP_PLAY_FIELD = 0,     // 点击主牌区卡牌
+    TAP_STACK = 1,          // 点击备用牌堆顶部牌
+    UNDO = 2,               // 回退
+    REDO = 3                // 重做
+};
+
+/**
+ * @brief 一条操作
+ */
+struct MoveLogEntry
+{
+    MoveLogAction action;   // 操作类型
+    int32_t cardId;         // 被点击的卡牌ID（UNDO/REDO为0）
+};
+
+/**
+ * @brief 一局游戏的操作记录
+ * 只记录发牌种子、关卡ID和玩家操作，牌局由GameModelFromLevelGenerator按种子重新生成
+ * 编码（小端）：24字节文件头 | 每条操作一个变长整数（cardId << 2 | action，7位一组，高位为续位）
+ * 大多数操作只占1~2字节
+ */
+class MoveLog
+{
+public:
+    static const uint32_t MAGIC = 0x474C564D;   // "MVLG"
+    static const uint16_t VERSION = 1;
+    static const size_t HEADER_SIZE = 24;
+    
+    MoveLog();
+    
+    /**
+     * @brief 清空操作并设置新的一局
+     * @param levelId 关卡ID
+     * @param seed 发牌种子
+     */
+    void reset(int levelId, uint64_t seed);
+    
+    /**
+     * @brief 获取关卡ID和发牌种子
+     */
+    int getLevelId() const { return _levelId; }
+    uint64_t getSeed() const { return _seed; }
+    
+    /**
+     * @brief 追加一条操作
+     * @param action 操作类型
+     * @param cardId 被点击的卡牌ID（UNDO/REDO忽略）
+     */
+    void append(MoveLogAction action, int cardId = 0);
+    
+    /**
+     * @brief 获取所有操作（按时间顺序）
+     */
+    const std::vector<MoveLogEntry>& getEntries() const { return _entries; }
+    
+    /**
+     * @brief 编码后的字节数
+     */
+    size_t getEncodedSize() const;
+    
+    /**
+     * @brief 编码写入缓冲区
+     * @param buffer 目标缓冲区
+     * @param capacity 缓冲区大小
+     * @return 写入的字节数，缓冲区不足时返回0
+     */
+    size_t write(void* buffer, size_t capacity) const;
+    
+    /**
+     * @brief 从编码数据读取（不可信输入：校验文件头、操作类型、卡牌ID和长度）
+     * @param buffer 编码数据
+     * @param size 字节数
+     * @return 是否读取成功，失败时记录被清空
+     */
+    bool read(const void* buffer, size_t size);
+
+private:
+    int _levelId;                       // 关卡ID
+    uint64_t _seed;                     // 发牌种子
+    std::vector<MoveLogEntry> _entries; // 操作（按时间顺序）
+};
+
+#endif // __MOVE_LOG_H__
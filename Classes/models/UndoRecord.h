@@ -0,0 +1,57 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __UNDO_RECORD_H__
+#define __UNDO_RECORD_H__
+
+#include <cstdint>
+
+/**
+ * @brief 操作类型枚举
+ */
+enum class UndoActionType : uint8_t
+{
+    ELIMINATE_CARD,            // 消除主牌堆的卡牌
+    REPLACE_BOTTOM_CARD        // 替换底牌
+};
+
+/**
+ * @brief 撤销记录（16字节定长数据）
+ * 只记录卡牌ID和主牌堆下标，卡牌数据随时可从GameModel按ID取得，不再深拷贝
+ * 正向执行：消除时从主牌堆移除cardId，替换时翻开备用牌堆顶部牌，然后cardId成为底牌
+ * 撤销：replacedCardId恢复为底牌，cardId放回主牌堆原位置或备用牌堆顶部
+ */
+struct UndoRecord
+{
+    int32_t cardId;             // 新底牌ID（被消除的主牌堆卡牌或翻开的备用牌）
+    int32_t replacedCardId;     // 被替换的底牌ID
+    int32_t playFieldIndex;     // 消除前在主牌堆中的下标（替换操作为-1）
+    UndoActionType actionType;  // 操作类型
+    uint8_t reserved[3];        // 保留（填0）
+};
+
+static_assert(sizeof(UndoRecord) == 16, "UndoRecord must stay 16 bytes");
+
+#endif // __UNDO_RECORD_H__
@@ -26,9 +26,117 @@
 #include "../configs/models/LevelConfig.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
-#include "../utils/CommonUtils.h"
+#include "../utils/RandomGenerator.h"
+#include "../utils/WorkStealingPool.h"
+#include <algorithm>
+
+namespace
+{
+    inline int randomBelow(RandomGenerator& random, int bound)
+    {
+        return (int)random.nextBelow((uint32_t)bound);
+    }
+    
+    inline CardSuitType randomSuit(RandomGenerator& random)
+    {
+        return (CardSuitType)randomBelow(random, CST_NUM_CARD_SUIT_TYPES);
+    }
+    
+    inline int randomFace(RandomGenerator& random)
+    {
+        return randomBelow(random, CFT_NUM_CARD_FACE_TYPES);
+    }
+    
+    inline bool isValidCover(const PlayFieldCoverConfig& cover, int playCount)
+    {
+        return cover.coverIndex >= 0 && cover.coverIndex < playCount
+            && cover.coveredIndex >= 0 && cover.coveredIndex < playCount
+            && cover.coverIndex != cover.coveredIndex;
+    }
+    
+    /**
+     * @brief 按关卡配置的位置添加主牌区遮挡关系（越界的关系忽略）
+     */
+    void applyPlayFieldCovers(const LevelConfig* levelConfig, const std::vector<int>& playFieldCardIds, GameModel* gameModel)
+    {
+        int playCount = (int)playFieldCardIds.size();
+        for (const PlayFieldCoverConfig& cover : levelConfig->getPlayFieldCovers())
+        {
+            if (isValidCover(cover, playCount))
+            {
+                gameModel->addCover(playFieldCardIds[cover.coverIndex], playFieldCardIds[cover.coveredIndex]);
+            }
+        }
+    }
+    
+    /**
+     * @brief 随机拓扑序：每一步在当前未被遮挡的位置中等概率选一个消除
+     * 遮挡关系成环时（关卡包编译器会拒绝），环上的位置按下标追加到末尾
+     */
+    std::vector<int> randomTopologicalOrder(const std::vector<PlayFieldCoverConfig>& covers, int playCount,
+                                            RandomGenerator& random)
+    {
+        std::vector<int> coveringCounts(playCount, 0);
+        std::vector<std::vector<int>> coveredIndices(playCount);
+        for (const PlayFieldCoverConfig& cover : covers)
+        {
+            if (isValidCover(cover, playCount))
+            {
+                ++coveringCounts[cover.coveredIndex];
+                coveredIndices[cover.coverIndex].push_back(cover.coveredIndex);
+            }
+        }
+        
+        std::vector<int> exposed;
+        for (int i = 0; i < playCount; ++i)
+        {
+            if (coveringCounts[i] == 0)
+            {
+                exposed.push_back(i);
+            }
+        }
+        
+        std::vector<int> order;
+        order.reserve(playCount);
+        while (!exposed.empty())
+        {
+            int pick = randomBelow(random, (int)exposed.size());
+            int index = exposed[pick];
+            exposed[pick] = exposed.back();
+            exposed.pop_back();
+            order.push_back(index);
+            for (int coveredIndex : coveredIndices[index])
+            {
+                if (--coveringCounts[coveredIndex] == 0)
+                {
+                    exposed.push_back(coveredIndex);
+                }
+            }
+        }
+        
+        for (int i = 0; i < playCount && (int)order.size() < playCount; ++i)
+        {
+            if (coveringCounts[i] > 0)
+            {
+                order.push_back(i);
+            }
+        }
+        return order;
+    }
+}
 
 GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelConfig* levelConfig)
+{
+    return generateGameModel(levelConfig, RandomGenerator::getThreadDefault());
+}
+
+GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelConfig* levelConfig, uint64_t seed)
+{
+    RandomGenerator random(seed);
+    return generateGameModel(levelConfig, random);
+}
+
+GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelConfig* levelConfig, RandomGenerator& random)
 {
     if (levelConfig == nullptr)
     {
@@ -36,79 +144,284 @@ GameModel* GameModelFromLevelGenerator::generateGameModel(const LevelConfig* lev
     }
     
     GameModel* gameModel = new GameModel();
+    fillGameModel(levelConfig, random, gameModel);
+    return gameModel;
+}
+
+bool GameModelFromLevelGenerator::regenerateGameModel(const LevelConfig* levelConfig, uint64_t seed, GameModel* gameModel)
+{
+    RandomGenerator random(seed);
+    return fillGameModel(levelConfig, random, gameModel);
+}
+
+bool GameModelFromLevelGenerator::fillGameModel(const LevelConfig* levelConfig, RandomGenerator& random, GameModel* gameModel)
+{
+    if (levelConfig == nullptr || gameModel == nullptr)
+    {
+        return false;
+    }
+    
+    // clear保留已分配的容量，同一关卡重新发牌不再分配
+    gameModel->clear();
     gameModel->setLevelId(levelConfig->getLevelId());
     
     int cardIdCounter = 1;
     
-    // 生成主牌区卡牌（8张牌）
-    std::vector<int> playFieldCardIds = levelConfig->getPlayFieldCards();
-    if (playFieldCardIds.empty())
+    // 主牌区卡牌ID（8张牌），有配置时直接引用，不复制
+    std::vector<int> generatedPlayFieldCardIds;
+    if (levelConfig->getPlayFieldCards().empty())
     {
         // 如果没有配置，生成8张随机卡牌
-        playFieldCardIds = generateRandomCards(8, cardIdCounter);
+        generatedPlayFieldCardIds = generateRandomCards(8, cardIdCounter, random);
         cardIdCounter += 8;
     }
+    const std::vector<int>& playFieldCardIds = generatedPlayFieldCardIds.empty()
+        ? levelConfig->getPlayFieldCards() : generatedPlayFieldCardIds;
     
+    // 备用牌堆卡牌ID
+    std::vector<int> generatedStackCardIds;
+    if (levelConfig->getStackCards().empty())
+    {
+        // 如果没有配置，生成12张随机卡牌
+        generatedStackCardIds = generateRandomCards(12, cardIdCounter, random);
+        cardIdCounter += 12;
+    }
+    const std::vector<int>& stackCardIds = generatedStackCardIds.empty()
+        ? levelConfig->getStackCards() : generatedStackCardIds;
+    
+    // 卡牌ID即存储下标，先按最大ID预留空间
+    int maxCardId = cardIdCounter;
     for (int cardId : playFieldCardIds)
     {
-        // 生成随机卡牌数据（示例）
-        CardSuitType suit = (CardSuitType)CommonUtils::randomInt(0, CST_NUM_CARD_SUIT_TYPES - 1);
-        CardFaceType face = (CardFaceType)CommonUtils::randomInt(0, CFT_NUM_CARD_FACE_TYPES - 1);
-        
-        CardModel* card = new CardModel(cardId, suit, face);
-        gameModel->addCard(card);
-        gameModel->getPlayFieldCardIds().push_back(cardId);
+        maxCardId = std::max(maxCardId, cardId);
     }
+    for (int cardId : stackCardIds)
+    {
+        maxCardId = std::max(maxCardId, cardId);
+    }
+    gameModel->reserveCards(maxCardId);
     
-    // 生成备用牌堆卡牌
-    std::vector<int> stackCardIds = levelConfig->getStackCards();
-    if (stackCardIds.empty())
+    // 生成主牌区卡牌
+    for (int cardId : playFieldCardIds)
     {
-        // 如果没有配置，生成12张随机卡牌
-        stackCardIds = generateRandomCards(12, cardIdCounter);
-        cardIdCounter += 12;
+        // 生成随机卡牌数据（示例）
+        CardSuitType suit = randomSuit(random);
+        CardFaceType face = (CardFaceType)randomFace(random);
+        
+        gameModel->addCard(cardId, suit, face);
+        gameModel->addToPlayField(cardId);
     }
+    applyPlayFieldCovers(levelConfig, playFieldCardIds, gameModel);
     
+    // 生成备用牌堆卡牌
     for (int cardId : stackCardIds)
     {
         // 生成随机卡牌数据（示例）
-        CardSuitType suit = (CardSuitType)CommonUtils::randomInt(0, CST_NUM_CARD_SUIT_TYPES - 1);
-        CardFaceType face = (CardFaceType)CommonUtils::randomInt(0, CFT_NUM_CARD_FACE_TYPES - 1);
+        CardSuitType suit = randomSuit(random);
+        CardFaceType face = (CardFaceType)randomFace(random);
         
-        CardModel* card = new CardModel(cardId, suit, face);
-        gameModel->addCard(card);
-        gameModel->getStackCardIds().push_back(cardId);
+        gameModel->addCard(cardId, suit, face);
+        gameModel->addToStackTop(cardId);
     }
     
     // 生成底牌（从备用牌堆顶部取一张，如果没有则生成一张）
     if (!stackCardIds.empty())
     {
-        int bottomCardId = stackCardIds.back();
-        gameModel->getStackCardIds().pop_back();
+        int bottomCardId = gameModel->removeTopFromStack();
         gameModel->setBottomCardId(bottomCardId);
     }
     else
     {
         // 如果没有备用牌堆，生成一张底牌
         int bottomCardId = cardIdCounter++;
-        CardSuitType suit = (CardSuitType)CommonUtils::randomInt(0, CST_NUM_CARD_SUIT_TYPES - 1);
-        CardFaceType face = (CardFaceType)CommonUtils::randomInt(0, CFT_NUM_CARD_FACE_TYPES - 1);
-        CardModel* bottomCard = new CardModel(bottomCardId, suit, face);
-        gameModel->addCard(bottomCard);
+        CardSuitType suit = randomSuit(random);
+        CardFaceType face = (CardFaceType)randomFace(random);
+        gameModel->addCard(bottomCardId, suit, face);
         gameModel->setBottomCardId(bottomCardId);
     }
     
-    return gameModel;
+    return true;
 }
 
 std::vector<int> GameModelFromLevelGenerator::generateRandomCards(int count, int startCardId)
+{
+    return generateRandomCards(count, startCardId, RandomGenerator::getThreadDefault());
+}
+
+std::vector<int> GameModelFromLevelGenerator::generateRandomCards(int count, int startCardId, RandomGenerator& random)
 {
     std::vector<int> cardIds;
     for (int i = 0; i < count; ++i)
     {
         cardIds.push_back(startCardId + i);
     }
-    CommonUtils::shuffleVector(cardIds);
+    random.shuffle(cardIds);
     return cardIds;
 }
 
+GameModel* GameModelFromLevelGenerator::generateSolvableGameModel(const LevelConfig* levelConfig, uint64_t seed, float difficulty)
+{
+    if (levelConfig == nullptr)
+    {
+        return nullptr;
+    }
+    
+    difficulty = std::min(1.0f, std::max(0.0f, difficulty));
+    RandomGenerator random(seed);
+    
+    // 卡牌ID规则与generateGameModel一致
+    int cardIdCounter = 1;
+    std::vector<int> playFieldCardIds = levelConfig->getPlayFieldCards();
+    if (playFieldCardIds.empty())
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            playFieldCardIds.push_back(cardIdCounter++);
+        }
+    }
+    std::vector<int> stackCardIds = levelConfig->getStackCards();
+    if (stackCardIds.empty())
+    {
+        for (int i = 0; i < 12; ++i)
+        {
+            stackCardIds.push_back(cardIdCounter++);
+        }
+    }
+    
+    int playCount = (int)playFieldCardIds.size();
+    int drawCount = (int)stackCardIds.size() - 1;  // 备用牌堆顶部一张作为底牌
+    
+    // 1. 把主牌区的消除切分成若干段，每段之前至少翻一张牌（第一段接在初始底牌之后）
+    int runCount = 1 + (int)(difficulty * (playCount - 1) + 0.5f);
+    runCount = std::max(1, std::min(runCount, std::min(playCount, drawCount + 1)));
+    std::vector<int> runLengths(runCount, 1);
+    for (int i = runCount; i < playCount; ++i)
+    {
+        ++runLengths[randomBelow(random, runCount)];
+    }
+    
+    // 2. 其余翻牌按难度插入获胜链中作为无用翻牌，否则放在获胜链结束之后（无需翻开）
+    std::vector<int> drawsBeforeRun(runCount, 1);
+    drawsBeforeRun[0] = 0;
+    int trailingDraws = 0;
+    for (int i = runCount - 1; i < drawCount; ++i)
+    {
+        if (random.nextBool(difficulty))
+        {
+            ++drawsBeforeRun[randomBelow(random, runCount)];
+        }
+        else
+        {
+            ++trailingDraws;
+        }
+    }
+    
+    // 3. 沿获胜链分配点数：翻牌任意点数，消除的牌与当前底牌相差1
+    int bottomFace = randomFace(random);
+    int currentFace = bottomFace;
+    std::vector<int> drawFaces;             // 按翻牌顺序
+    std::vector<int> eliminateFaces;        // 按消除顺序
+    for (int run = 0; run < runCount; ++run)
+    {
+        for (int i = 0; i < drawsBeforeRun[run]; ++i)
+        {
+            currentFace = randomFace(random);
+            drawFaces.push_back(currentFace);
+        }
+        for (int i = 0; i < runLengths[run]; ++i)
+        {
+            int step = randomBelow(random, 2) == 0 ? 1 : CFT_NUM_CARD_FACE_TYPES - 1;
+            currentFace = (currentFace + step) % CFT_NUM_CARD_FACE_TYPES;
+            eliminateFaces.push_back(currentFace);
+        }
+    }
+    for (int i = 0; i < trailingDraws; ++i)
+    {
+        drawFaces.push_back(randomFace(random));
+    }
+    
+    // 4. 没有遮挡时消除顺序与主牌区摆放位置无关，有遮挡时取随机拓扑序（上层先于被遮挡的牌）
+    std::vector<int> eliminateOrder;
+    if (levelConfig->getPlayFieldCovers().empty())
+    {
+        eliminateOrder.resize(playCount);
+        for (int i = 0; i < playCount; ++i)
+        {
+            eliminateOrder[i] = i;
+        }
+        random.shuffle(eliminateOrder);
+    }
+    else
+    {
+        eliminateOrder = randomTopologicalOrder(levelConfig->getPlayFieldCovers(), playCount, random);
+    }
+    std::vector<int> playFieldFaces(playCount);
+    for (int i = 0; i < playCount; ++i)
+    {
+        playFieldFaces[eliminateOrder[i]] = eliminateFaces[i];
+    }
+    
+    GameModel* gameModel = new GameModel();
+    gameModel->setLevelId(levelConfig->getLevelId());
+    
+    int maxCardId = cardIdCounter;
+    for (int cardId : playFieldCardIds)
+    {
+        maxCardId = std::max(maxCardId, cardId);
+    }
+    for (int cardId : stackCardIds)
+    {
+        maxCardId = std::max(maxCardId, cardId);
+    }
+    gameModel->reserveCards(maxCardId);
+    
+    for (int i = 0; i < playCount; ++i)
+    {
+        gameModel->addCard(playFieldCardIds[i], randomSuit(random), (CardFaceType)playFieldFaces[i]);
+        gameModel->addToPlayField(playFieldCardIds[i]);
+    }
+    applyPlayFieldCovers(levelConfig, playFieldCardIds, gameModel);
+    
+    // 备用牌堆从底部到顶部存储：顶部为底牌，其下依次为第1、2...张翻开的牌
+    for (int i = 0; i <= drawCount; ++i)
+    {
+        int face = (i == drawCount) ? bottomFace : drawFaces[drawCount - 1 - i];
+        gameModel->addCard(stackCardIds[i], randomSuit(random), (CardFaceType)face);
+        gameModel->addToStackTop(stackCardIds[i]);
+    }
+    gameModel->setBottomCardId(gameModel->removeTopFromStack());
+    
+    return gameModel;
+}
+
+std::vector<GameModel*> GameModelFromLevelGenerator::generateSolvableBatch(const LevelConfig* levelConfig, uint64_t seed,
+                                                                           float difficulty, int count, int threadCount)
+{
+    std::vector<GameModel*> gameModels(std::max(0, count), nullptr);
+    if (levelConfig == nullptr || count <= 0)
+    {
+        return gameModels;
+    }
+    
+    // 每个任务生成一段连续下标的牌局，写入各自的位置，无需加锁
+    const int chunkSize = 64;
+    WorkStealingPool pool(threadCount);
+    for (int begin = 0; begin < count; begin += chunkSize)
+    {
+        int end = std::min(count, begin + chunkSize);
+        pool.submit([&gameModels, levelConfig, seed, difficulty, begin, end](int) {
+            for (int i = begin; i < end; ++i)
+            {
+                gameModels[i] = generateSolvableGameModel(levelConfig, getBatchDealSeed(seed, i), difficulty);
+            }
+        });
+    }
+    pool.waitAll();
+    
+    return gameModels;
+}
+
+uint64_t GameModelFromLevelGenerator::getBatchDealSeed(uint64_t seed, int index)
+{
+    return RandomGenerator::mixSeed(seed ^ RandomGenerator::mixSeed((uint64_t)index));
+}
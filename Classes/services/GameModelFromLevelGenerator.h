@@ -25,11 +25,16 @@
 #ifndef __GAME_MODEL_FROM_LEVEL_GENERATOR_H__
 #define __GAME_MODEL_FROM_LEVEL_GENERATOR_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
+#include <cstdint>
+#include <vector>
 
 // 前向声明
 class LevelConfig;
 class GameModel;
+class RandomGenerator;
 
 /**
  * @brief 游戏模型生成服务
@@ -46,6 +51,61 @@ public:
      */
     static GameModel* generateGameModel(const LevelConfig* levelConfig);
     
+    /**
+     * @brief 从关卡配置生成游戏模型（相同的配置和种子总是生成相同的牌局，用于并行生成和回放校验）
+     * @param levelConfig 关卡配置
+     * @param seed 随机种子
+     * @return 游戏模型对象，失败返回nullptr
+     */
+    static GameModel* generateGameModel(const LevelConfig* levelConfig, uint64_t seed);
+    
+    /**
+     * @brief 从关卡配置生成游戏模型，随机数取自调用方的生成器
+     * @param levelConfig 关卡配置
+     * @param random 随机数生成器
+     * @return 游戏模型对象，失败返回nullptr
+     */
+    static GameModel* generateGameModel(const LevelConfig* levelConfig, RandomGenerator& random);
+    
+    /**
+     * @brief 清空已有的游戏模型并按关卡配置和种子重新发牌（结果与generateGameModel相同）
+     * 复用模型已分配的存储，重新开始同一关卡时不再分配内存
+     * @param levelConfig 关卡配置
+     * @param seed 随机种子
+     * @param gameModel 要重新填充的游戏模型
+     * @return 是否成功
+     */
+    static bool regenerateGameModel(const LevelConfig* levelConfig, uint64_t seed, GameModel* gameModel);
+    
+    /**
+     * @brief 生成保证可以获胜的游戏模型
+     * 先随机构造一条获胜步骤链（消除与翻牌交替，消除顺序满足主牌区遮挡关系），再按链上的点数反推主牌区、备用牌堆和底牌
+     * 卡牌ID规则与generateGameModel一致，相同的配置、种子和难度总是生成相同的牌局
+     * @param levelConfig 关卡配置
+     * @param seed 随机种子
+     * @param difficulty 目标难度（0~1）：越高获胜链被翻牌切分得越碎，无用翻牌越多
+     * @return 游戏模型对象，失败返回nullptr
+     */
+    static GameModel* generateSolvableGameModel(const LevelConfig* levelConfig, uint64_t seed, float difficulty);
+    
+    /**
+     * @brief 批量并行生成保证可以获胜的游戏模型
+     * 第i局的种子由seed和i推导，结果与线程数无关
+     * @param levelConfig 关卡配置
+     * @param seed 批次随机种子
+     * @param difficulty 目标难度（0~1）
+     * @param count 牌局数量
+     * @param threadCount 工作线程数，小于等于0时使用硬件并发数
+     * @return 游戏模型列表（按下标顺序，由调用方释放）
+     */
+    static std::vector<GameModel*> generateSolvableBatch(const LevelConfig* levelConfig, uint64_t seed, float difficulty,
+                                                         int count, int threadCount = 0);
+    
+    /**
+     * @brief 批次中第index局使用的种子（generateGameModel和generateSolvableGameModel通用）
+     */
+    static uint64_t getBatchDealSeed(uint64_t seed, int index);
+    
     /**
      * @brief 生成随机卡牌列表
      * @param count 卡牌数量
@@ -53,8 +113,14 @@ public:
      * @return 卡牌ID列表
      */
     static std::vector<int> generateRandomCards(int count, int startCardId = 1);
+    static std::vector<int> generateRandomCards(int count, int startCardId, RandomGenerator& random);
 
 private:
+    /**
+     * @brief 清空gameModel并按关卡配置发牌
+     */
+    static bool fillGameModel(const LevelConfig* levelConfig, RandomGenerator& random, GameModel* gameModel);
+    
     GameModelFromLevelGenerator() {}
     virtual ~GameModelFromLevelGenerator() {}
 };
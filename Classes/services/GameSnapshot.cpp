@@ -0,0 +1,450 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "GameSnapshot.h"
+#include "../models/GameModel.h"
+#include <bitset>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief 快照文件头（44字节）
+     */
+    struct SnapshotHeader
+    {
+        uint32_t magic;             // GameSnapshot::MAGIC
+        uint16_t version;           // GameSnapshot::VERSION
+        uint16_t headerSize;        // 文件头字节数
+        uint32_t totalSize;         // 快照总字节数
+        uint32_t checksum;          // 文件头之后所有数据的FNV-1a校验和
+        int32_t levelId;            // 关卡ID
+        int32_t bottomCardId;       // 底牌ID
+        uint32_t cardCount;         // 卡牌数量
+        uint32_t playFieldCount;    // 主牌堆卡牌数量
+        uint32_t stackCount;        // 备用牌堆卡牌数量
+        uint32_t undoCount;         // 撤销记录数量
+        uint32_t coverCount;        // 主牌区遮挡关系数量
+    };
+    
+    /**
+     * @brief 卡牌表条目（8字节）
+     */
+    struct SnapshotCard
+    {
+        int32_t cardId;
+        int8_t suit;
+        int8_t face;
+        uint8_t zone;               // CardZone
+        uint8_t reserved;
+    };
+    
+    static_assert(sizeof(SnapshotHeader) == 44, "snapshot header layout changed");
+    static_assert(sizeof(SnapshotCard) == 8, "snapshot card layout changed");
+    static_assert(sizeof(UndoRecord) == 16, "snapshot undo record layout changed");
+    
+    uint32_t computeChecksum(const unsigned char* data, size_t size)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+    
+    size_t computeSize(size_t cardCount, size_t playFieldCount, size_t stackCount, size_t coverCount, size_t undoCount)
+    {
+        return sizeof(SnapshotHeader)
+            + cardCount * sizeof(SnapshotCard)
+            + (playFieldCount + stackCount + coverCount * 2) * sizeof(int32_t)
+            + undoCount * sizeof(UndoRecord);
+    }
+    
+    /**
+     * @brief 顺序写入（缓冲区不要求对齐，统一用memcpy）
+     */
+    inline void writeBytes(unsigned char*& cursor, const void* data, size_t size)
+    {
+        memcpy(cursor, data, size);
+        cursor += size;
+    }
+    
+    inline void readBytes(const unsigned char*& cursor, void* data, size_t size)
+    {
+        memcpy(data, cursor, size);
+        cursor += size;
+    }
+    
+    typedef std::bitset<GameSnapshot::MAX_CARD_ID + 1> CardIdSet;
+    
+    inline bool isCardIdInRange(int32_t cardId)
+    {
+        return cardId >= 0 && cardId <= GameSnapshot::MAX_CARD_ID;
+    }
+    
+    /**
+     * @brief 读入主牌堆/备用牌堆的ID并登记到placed，ID必须已在卡牌表中且只出现一次
+     */
+    bool validatePile(const unsigned char*& cursor, uint32_t count, const CardIdSet& known, CardIdSet& placed)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            int32_t cardId;
+            readBytes(cursor, &cardId, sizeof(cardId));
+            if (!isCardIdInRange(cardId) || !known.test(cardId) || placed.test(cardId))
+            {
+                return false;
+            }
+            placed.set(cardId);
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 从恢复后的局面依次回退撤销记录（从新到旧），检查每一步都能被UndoManager正确回退
+     * 回退要求cardId是当前底牌、replacedCardId是已覆盖的底牌（开局前没有底牌时为-1），
+     * 消除操作的playFieldIndex不超过当时主牌堆的大小；逐步成立时重做也会回到同一局面，撤销/重做都不会重复或丢失卡牌
+     */
+    bool validateUndoRecords(const unsigned char* cursor, uint32_t undoCount, uint8_t* zones,
+                             uint32_t playFieldCount, int32_t bottomCardId)
+    {
+        const unsigned char* records = cursor;
+        for (uint32_t i = undoCount; i > 0; --i)
+        {
+            UndoRecord record;
+            memcpy(&record, records + (i - 1) * sizeof(UndoRecord), sizeof(record));
+            if (record.actionType != UndoActionType::ELIMINATE_CARD
+                && record.actionType != UndoActionType::REPLACE_BOTTOM_CARD)
+            {
+                return false;
+            }
+            if (bottomCardId < 0 || record.cardId != bottomCardId)
+            {
+                return false;
+            }
+            if (record.replacedCardId != -1
+                && (!isCardIdInRange(record.replacedCardId) || zones[record.replacedCardId] != (uint8_t)CardZone::DISCARD))
+            {
+                return false;
+            }
+            
+            if (record.actionType == UndoActionType::ELIMINATE_CARD)
+            {
+                if (record.playFieldIndex < 0 || (uint32_t)record.playFieldIndex > playFieldCount)
+                {
+                    return false;
+                }
+                zones[record.cardId] = (uint8_t)CardZone::PLAY_FIELD;
+                ++playFieldCount;
+            }
+            else
+            {
+                zones[record.cardId] = (uint8_t)CardZone::STACK;
+            }
+            bottomCardId = record.replacedCardId;
+            if (bottomCardId >= 0)
+            {
+                zones[bottomCardId] = (uint8_t)CardZone::BOTTOM;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 恢复前校验快照内容，保证之后的恢复步骤不会失败（位集和区域表在栈上，不分配内存）
+     * 卡牌ID在范围内且不重复，花色和点数在枚举范围内；主牌堆、备用牌堆和底牌引用已有且互不重复的卡牌；
+     * 每张卡牌记录的区域与所在牌堆一致（不在任何牌堆的卡牌只能是未放置或已覆盖）；遮挡关系引用两张不同的已有卡牌；
+     * 撤销记录可以从当前局面逐步回退
+     */
+    bool validateContent(const unsigned char* base, const SnapshotHeader& header)
+    {
+        if (header.cardCount > (uint32_t)GameSnapshot::MAX_CARD_ID + 1)
+        {
+            return false;
+        }
+        
+        const unsigned char* cards = base + sizeof(SnapshotHeader);
+        const unsigned char* cursor = cards;
+        CardIdSet known;
+        for (uint32_t i = 0; i < header.cardCount; ++i)
+        {
+            SnapshotCard card;
+            readBytes(cursor, &card, sizeof(card));
+            if (!isCardIdInRange(card.cardId) || known.test(card.cardId)
+                || card.suit < CST_NONE || card.suit >= CST_NUM_CARD_SUIT_TYPES
+                || card.face < CFT_NONE || card.face >= CFT_NUM_CARD_FACE_TYPES)
+            {
+                return false;
+            }
+            known.set(card.cardId);
+        }
+        
+        CardIdSet playField;
+        CardIdSet stack;
+        if (!validatePile(cursor, header.playFieldCount, known, playField)
+            || !validatePile(cursor, header.stackCount, known, stack)
+            || (playField & stack).any())
+        {
+            return false;
+        }
+        
+        int32_t bottomCardId = header.bottomCardId;
+        bool hasBottom = bottomCardId >= 0;
+        if (hasBottom && (!isCardIdInRange(bottomCardId) || !known.test(bottomCardId)
+                          || playField.test(bottomCardId) || stack.test(bottomCardId)))
+        {
+            return false;
+        }
+        
+        for (uint32_t i = 0; i < header.coverCount; ++i)
+        {
+            int32_t values[2];
+            readBytes(cursor, values, sizeof(values));
+            if (!isCardIdInRange(values[0]) || !isCardIdInRange(values[1]) || values[0] == values[1]
+                || !known.test(values[0]) || !known.test(values[1]))
+            {
+                return false;
+            }
+        }
+        
+        // 未出现在卡牌表中的ID保持NONE，撤销记录引用它们时会因区域不符被拒绝
+        uint8_t zones[GameSnapshot::MAX_CARD_ID + 1];
+        memset(zones, (int)CardZone::NONE, sizeof(zones));
+        for (uint32_t i = 0; i < header.cardCount; ++i)
+        {
+            SnapshotCard card;
+            memcpy(&card, cards + i * sizeof(SnapshotCard), sizeof(card));
+            CardZone expected = CardZone::NONE;
+            if (playField.test(card.cardId))
+            {
+                expected = CardZone::PLAY_FIELD;
+            }
+            else if (stack.test(card.cardId))
+            {
+                expected = CardZone::STACK;
+            }
+            else if (hasBottom && card.cardId == bottomCardId)
+            {
+                expected = CardZone::BOTTOM;
+            }
+            else if (card.zone == (uint8_t)CardZone::DISCARD)
+            {
+                expected = CardZone::DISCARD;
+            }
+            if (card.zone != (uint8_t)expected)
+            {
+                return false;
+            }
+            zones[card.cardId] = card.zone;
+        }
+        
+        return validateUndoRecords(cursor, header.undoCount, zones, header.playFieldCount, bottomCardId);
+    }
+}
+
+size_t GameSnapshot::getSnapshotSize(const GameModel* gameModel, size_t undoCount)
+{
+    if (gameModel == nullptr)
+    {
+        return 0;
+    }
+    return computeSize(gameModel->getCardIds().size(), gameModel->getPlayFieldCardIds().size(),
+                       gameModel->getStackCardIds().size(), gameModel->getCovers().size(), undoCount);
+}
+
+size_t GameSnapshot::write(const GameModel* gameModel, const UndoRecord* undoRecords, size_t undoCount,
+                           void* buffer, size_t capacity)
+{
+    if (gameModel == nullptr || buffer == nullptr || (undoRecords == nullptr && undoCount > 0))
+    {
+        return 0;
+    }
+    
+    const std::vector<int>& cardIds = gameModel->getCardIds();
+    const std::vector<int>& playFieldCardIds = gameModel->getPlayFieldCardIds();
+    const std::vector<int>& stackCardIds = gameModel->getStackCardIds();
+    const std::vector<CardCover>& covers = gameModel->getCovers();
+    size_t totalSize = computeSize(cardIds.size(), playFieldCardIds.size(), stackCardIds.size(), covers.size(), undoCount);
+    if (totalSize > capacity || totalSize > UINT32_MAX)
+    {
+        return 0;
+    }
+    
+    for (int cardId : cardIds)
+    {
+        // 超出范围的ID恢复时会被拒绝，不写出无法读回的快照
+        if (!isCardIdInRange(cardId))
+        {
+            return 0;
+        }
+    }
+    
+    unsigned char* base = static_cast<unsigned char*>(buffer);
+    unsigned char* cursor = base + sizeof(SnapshotHeader);
+    
+    for (int cardId : cardIds)
+    {
+        SnapshotCard card;
+        card.cardId = cardId;
+        card.suit = (int8_t)gameModel->getCardSuit(cardId);
+        card.face = (int8_t)gameModel->getCardFace(cardId);
+        card.zone = (uint8_t)gameModel->getCardZone(cardId);
+        card.reserved = 0;
+        writeBytes(cursor, &card, sizeof(card));
+    }
+    for (int cardId : playFieldCardIds)
+    {
+        int32_t value = cardId;
+        writeBytes(cursor, &value, sizeof(value));
+    }
+    for (int cardId : stackCardIds)
+    {
+        int32_t value = cardId;
+        writeBytes(cursor, &value, sizeof(value));
+    }
+    for (const CardCover& cover : covers)
+    {
+        int32_t values[2] = { cover.coverCardId, cover.coveredCardId };
+        writeBytes(cursor, values, sizeof(values));
+    }
+    if (undoCount > 0)
+    {
+        writeBytes(cursor, undoRecords, undoCount * sizeof(UndoRecord));
+    }
+    
+    SnapshotHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.headerSize = (uint16_t)sizeof(SnapshotHeader);
+    header.totalSize = (uint32_t)totalSize;
+    header.checksum = computeChecksum(base + sizeof(SnapshotHeader), totalSize - sizeof(SnapshotHeader));
+    header.levelId = gameModel->getLevelId();
+    header.bottomCardId = gameModel->getBottomCardId();
+    header.cardCount = (uint32_t)cardIds.size();
+    header.playFieldCount = (uint32_t)playFieldCardIds.size();
+    header.stackCount = (uint32_t)stackCardIds.size();
+    header.undoCount = (uint32_t)undoCount;
+    header.coverCount = (uint32_t)covers.size();
+    memcpy(base, &header, sizeof(header));
+    
+    return totalSize;
+}
+
+bool GameSnapshot::read(const void* buffer, size_t size, GameModel* gameModel, std::vector<UndoRecord>* undoRecords)
+{
+    if (buffer == nullptr || gameModel == nullptr || size < sizeof(SnapshotHeader))
+    {
+        return false;
+    }
+    
+    const unsigned char* base = static_cast<const unsigned char*>(buffer);
+    SnapshotHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (header.magic != MAGIC || header.version != VERSION || header.headerSize != sizeof(SnapshotHeader))
+    {
+        return false;
+    }
+    
+    size_t totalSize = computeSize(header.cardCount, header.playFieldCount, header.stackCount, header.coverCount,
+                                   header.undoCount);
+    if (header.totalSize != totalSize || totalSize > size)
+    {
+        return false;
+    }
+    if (computeChecksum(base + sizeof(SnapshotHeader), totalSize - sizeof(SnapshotHeader)) != header.checksum)
+    {
+        return false;
+    }
+    
+    if (!validateContent(base, header))
+    {
+        return false;
+    }
+    
+    // 数据完整且一致，开始恢复（以下步骤不会失败）
+    gameModel->clear();
+    gameModel->setLevelId(header.levelId);
+    
+    const unsigned char* cursor = base + sizeof(SnapshotHeader);
+    const unsigned char* zones = cursor;
+    int maxCardId = -1;
+    for (uint32_t i = 0; i < header.cardCount; ++i)
+    {
+        SnapshotCard card;
+        memcpy(&card, cursor + i * sizeof(SnapshotCard), sizeof(card));
+        maxCardId = card.cardId > maxCardId ? card.cardId : maxCardId;
+    }
+    gameModel->reserveCards(maxCardId);
+    
+    for (uint32_t i = 0; i < header.cardCount; ++i)
+    {
+        SnapshotCard card;
+        readBytes(cursor, &card, sizeof(card));
+        gameModel->addCard(card.cardId, (CardSuitType)card.suit, (CardFaceType)card.face);
+    }
+    for (uint32_t i = 0; i < header.playFieldCount; ++i)
+    {
+        int32_t cardId;
+        readBytes(cursor, &cardId, sizeof(cardId));
+        gameModel->addToPlayField(cardId);
+    }
+    for (uint32_t i = 0; i < header.stackCount; ++i)
+    {
+        int32_t cardId;
+        readBytes(cursor, &cardId, sizeof(cardId));
+        gameModel->addToStackTop(cardId);
+    }
+    gameModel->setBottomCardId(header.bottomCardId);
+    for (uint32_t i = 0; i < header.coverCount; ++i)
+    {
+        int32_t values[2];
+        readBytes(cursor, values, sizeof(values));
+        gameModel->addCover(values[0], values[1]);
+    }
+    
+    // 区域由主牌堆、备用牌堆和底牌推导，已覆盖的底牌按快照中的记录恢复
+    for (uint32_t i = 0; i < header.cardCount; ++i)
+    {
+        SnapshotCard card;
+        memcpy(&card, zones + i * sizeof(SnapshotCard), sizeof(card));
+        if (card.zone == (uint8_t)CardZone::DISCARD)
+        {
+            gameModel->discardCard(card.cardId);
+        }
+    }
+    
+    if (undoRecords != nullptr)
+    {
+        undoRecords->resize(header.undoCount);
+        if (header.undoCount > 0)
+        {
+            readBytes(cursor, undoRecords->data(), header.undoCount * sizeof(UndoRecord));
+        }
+    }
+    
+    return true;
+}
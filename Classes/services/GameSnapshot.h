@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __GAME_SNAPSHOT_H__
+#define __GAME_SNAPSHOT_H__
+
+#include "../models/UndoRecord.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 前向声明
+class GameModel;
+
+/**
+ * @brief 游戏快照服务
+ * 将GameModel和撤销记录写成带版本号的定长二进制格式，用于自动存档、崩溃恢复和重开
+ * 布局（小端）：文件头 | 卡牌表 | 主牌堆ID | 备用牌堆ID（从底部到顶部）| 遮挡关系（上层ID, 下层ID）| 撤销记录
+ * 写入调用方提供的缓冲区，恢复时复用GameModel已有的容量，不产生额外分配
+ */
+class GameSnapshot
+{
+public:
+    static const uint32_t MAGIC = 0x5347454D;   // "MEGS"
+    static const uint16_t VERSION = 3;   // 2: 撤销记录改为16字节UndoRecord；3: 增加主牌区遮挡关系
+    static const int MAX_CARD_ID = 4095;        // 允许的最大卡牌ID（恢复时按ID预留容量）
+    
+    /**
+     * @brief 计算快照所需字节数
+     * @param gameModel 游戏模型
+     * @param undoCount 撤销记录数量
+     */
+    static size_t getSnapshotSize(const GameModel* gameModel, size_t undoCount);
+    
+    /**
+     * @brief 写入快照
+     * @param gameModel 游戏模型
+     * @param undoRecords 撤销记录（从旧到新），可为nullptr
+     * @param undoCount 撤销记录数量
+     * @param buffer 目标缓冲区
+     * @param capacity 缓冲区大小
+     * @return 写入的字节数，缓冲区不足、参数无效或卡牌ID超过MAX_CARD_ID时返回0
+     */
+    static size_t write(const GameModel* gameModel, const UndoRecord* undoRecords, size_t undoCount,
+                        void* buffer, size_t capacity);
+    
+    /**
+     * @brief 从快照恢复
+     * 先校验文件头、长度、校验和以及卡牌ID、区域和遮挡关系，全部通过后才修改gameModel（失败时gameModel保持原样）
+     * @param buffer 快照数据
+     * @param size 快照字节数
+     * @param gameModel 恢复目标（原有数据会被清除）
+     * @param undoRecords 输出撤销记录（从旧到新），可为nullptr
+     * @return 是否恢复成功
+     */
+    static bool read(const void* buffer, size_t size, GameModel* gameModel, std::vector<UndoRecord>* undoRecords);
+
+private:
+    GameSnapshot() {}
+    virtual ~GameSnapshot() {}
+};
+
+#endif // __GAME_SNAPSHOT_H__
@@ -0,0 +1,490 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "GameSolver.h"
+#include "../models/GameModel.h"
+#include "../models/CardModel.h"
+#include "../utils/TraceRecorder.h"
+#include <algorithm>
+
+namespace
+{
+    const int FACE_COUNT = CFT_NUM_CARD_FACE_TYPES;     // 点数种类数（13）
+    const int FACE_NONE = FACE_COUNT;                    // 无底牌/无效点数
+    const uint16_t DEAD_END = 0xFFFF;                    // 置换表中表示任意预算都无解
+    
+    const int STACK_SHIFT = GameSolver::MAX_PLAY_FIELD_CARDS;  // 备用牌堆已翻张数的位偏移
+    const int FACE_SHIFT = STACK_SHIFT + 12;                    // 底牌点数的位偏移
+    
+    /**
+     * @brief 置换表（开放寻址）
+     * 键为0表示空槽：主牌区清空的状态直接返回，不会写入表中
+     */
+    class TranspositionTable
+    {
+    public:
+        TranspositionTable()
+        : _size(0)
+        {
+            _keys.assign(1 << 12, 0);
+            _values.assign(1 << 12, 0);
+        }
+        
+        size_t size() const { return _size; }
+        
+        bool find(uint64_t key, uint16_t& value) const
+        {
+            size_t mask = _keys.size() - 1;
+            for (size_t slot = hash(key) & mask; _keys[slot] != 0; slot = (slot + 1) & mask)
+            {
+                if (_keys[slot] == key)
+                {
+                    value = _values[slot];
+                    return true;
+                }
+            }
+            return false;
+        }
+        
+        void insert(uint64_t key, uint16_t value)
+        {
+            if ((_size + 1) * 2 > _keys.size())
+            {
+                grow();
+            }
+            size_t mask = _keys.size() - 1;
+            size_t slot = hash(key) & mask;
+            while (_keys[slot] != 0 && _keys[slot] != key)
+            {
+                slot = (slot + 1) & mask;
+            }
+            if (_keys[slot] == 0)
+            {
+                ++_size;
+            }
+            _keys[slot] = key;
+            _values[slot] = value;
+        }
+        
+    private:
+        static size_t hash(uint64_t key)
+        {
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            return (size_t)key;
+        }
+        
+        void grow()
+        {
+            std::vector<uint64_t> oldKeys;
+            std::vector<uint16_t> oldValues;
+            oldKeys.swap(_keys);
+            oldValues.swap(_values);
+            _keys.assign(oldKeys.size() * 2, 0);
+            _values.assign(oldValues.size() * 2, 0);
+            _size = 0;
+            for (size_t i = 0; i < oldKeys.size(); ++i)
+            {
+                if (oldKeys[i] != 0)
+                {
+                    insert(oldKeys[i], oldValues[i]);
+                }
+            }
+        }
+        
+        std::vector<uint64_t> _keys;
+        std::vector<uint16_t> _values;
+        size_t _size;
+    };
+    
+    /**
+     * @brief 求解上下文
+     * 主牌区卡牌按下标编码为位图，备用牌堆按翻牌顺序（顶部在前）排列
+     */
+    struct SolverContext
+    {
+        std::vector<int> playFieldCardIds;          // 主牌区下标 -> 卡牌ID
+        std::vector<int> stackCardIds;              // 翻牌顺序 -> 卡牌ID
+        std::vector<int> stackFaces;                // 翻牌顺序 -> 点数
+        std::vector<int> neighborPositions[FACE_COUNT];  // 点数 -> 与其相邻点数的备用牌的翻牌顺序位置
+        std::vector<uint16_t> neighborCounts;       // [已翻张数 * FACE_COUNT + 点数] -> 已翻开的相邻点数备用牌数
+        uint64_t faceMasks[FACE_COUNT];             // 每种点数在主牌区的位图
+        std::vector<uint64_t> coveringMasks;        // 主牌区下标 -> 遮挡它的卡牌位图
+        std::vector<uint64_t> coveredMasks;         // 主牌区下标 -> 它遮挡的卡牌位图
+        bool hasCovers;                             // 是否有遮挡关系（没有时剩余卡牌全部可点击）
+        TranspositionTable table;                   // 置换表：状态键 -> 已证明失败的最大翻牌预算
+        size_t visitedStates;                       // 已展开的状态数
+        size_t maxStates;                           // 状态上限
+        const std::atomic<bool>* cancelFlag;        // 取消标志（可为nullptr）
+        bool aborted;                               // 是否因超出状态上限或被取消而中止
+    };
+    
+    inline uint64_t makeKey(uint64_t remainingMask, int drawnCount, int bottomFace)
+    {
+        return remainingMask
+            | ((uint64_t)drawnCount << STACK_SHIFT)
+            | ((uint64_t)bottomFace << FACE_SHIFT);
+    }
+    
+    inline int lowestBitIndex(uint64_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(mask);
+#else
+        int index = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+    
+    /**
+     * @brief 剩余卡牌中没有被剩余卡牌遮挡的位图
+     */
+    inline uint64_t exposedCards(const SolverContext& context, uint64_t remainingMask)
+    {
+        if (!context.hasCovers)
+        {
+            return remainingMask;
+        }
+        uint64_t exposedMask = 0;
+        for (uint64_t mask = remainingMask; mask != 0; mask &= mask - 1)
+        {
+            int index = lowestBitIndex(mask);
+            if ((remainingMask & context.coveringMasks[index]) == 0)
+            {
+                exposedMask |= (uint64_t)1 << index;
+            }
+        }
+        return exposedMask;
+    }
+    
+    inline int bitCount(uint64_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(mask);
+#else
+        int count = 0;
+        for (; mask != 0; mask &= mask - 1)
+        {
+            ++count;
+        }
+        return count;
+#endif
+    }
+    
+    /**
+     * @brief 估算剩余翻牌数下界
+     * 每消除一张点数为f的牌，之前都需要一次"到达"f-1或f+1（消除该点数的牌、翻开该点数的备用牌或当前底牌），
+     * 且每次到达只能接一次消除。主牌区和底牌提供不了的到达次数（缺口）只能由翻牌补足：
+     * 下界取所有缺口之和，以及按翻牌顺序凑齐任一点数缺口所需的翻牌数中的较大者
+     * 遮挡只会减少可走的步骤，忽略遮挡计算的缺口仍是下界
+     * @return 翻牌数下界，无论翻多少张都无法补足时返回DEAD_END
+     */
+    inline int lowerBoundDraws(const SolverContext& context, uint64_t remainingMask, uint64_t exposedMask,
+                               int drawnCount, int bottomFace)
+    {
+        int remaining[FACE_COUNT];
+        for (int face = 0; face < FACE_COUNT; ++face)
+        {
+            remaining[face] = bitCount(remainingMask & context.faceMasks[face]);
+        }
+        
+        int totalDeficit = 0;
+        int longestReach = 0;
+        for (int face = 0; face < FACE_COUNT; ++face)
+        {
+            if (remaining[face] == 0)
+            {
+                continue;
+            }
+            int lower = (face + FACE_COUNT - 1) % FACE_COUNT;
+            int upper = (face + 1) % FACE_COUNT;
+            int supply = remaining[lower] + remaining[upper];
+            if (bottomFace == lower || bottomFace == upper)
+            {
+                ++supply;
+            }
+            int deficit = remaining[face] - supply;
+            if (deficit <= 0)
+            {
+                continue;
+            }
+            
+            // 第deficit张相邻点数的备用牌在翻牌顺序中的位置
+            const std::vector<int>& positions = context.neighborPositions[face];
+            size_t target = context.neighborCounts[drawnCount * FACE_COUNT + face] + deficit - 1;
+            if (target >= positions.size())
+            {
+                return DEAD_END;
+            }
+            totalDeficit += deficit;
+            longestReach = std::max(longestReach, positions[target] - drawnCount + 1);
+        }
+        
+        // 当前底牌无法消除任何未被遮挡的牌时至少还要翻一张
+        int minimum = 1;
+        if (bottomFace != FACE_NONE
+            && (exposedMask & (context.faceMasks[(bottomFace + 1) % FACE_COUNT]
+                               | context.faceMasks[(bottomFace + FACE_COUNT - 1) % FACE_COUNT])) != 0)
+        {
+            minimum = 0;
+        }
+        return std::max(minimum, std::max(totalDeficit, longestReach));
+    }
+    
+    inline int toFaceIndex(CardFaceType face)
+    {
+        if (face == CFT_NONE)
+        {
+            return FACE_NONE;
+        }
+        return (int)face;
+    }
+    
+    /**
+     * @brief 在翻牌预算内搜索获胜步骤（深度优先，优先消除）
+     * 只能消除没有被剩余卡牌遮挡的卡牌；不遮挡任何剩余卡牌的同点数卡牌可互换，因此只尝试其中最低位的一张，
+     * 遮挡其他卡牌的逐张尝试（消除后翻开的卡牌不同）
+     * 置换表记录每个状态已证明失败的最大翻牌预算，预算不超过该值时直接剪枝
+     * @param budget 剩余可用的翻牌次数
+     * @param moves 找到解时按逆序写入步骤
+     * @return 是否找到获胜步骤
+     */
+    bool search(SolverContext& context, uint64_t remainingMask, int drawnCount, int bottomFace,
+                int budget, std::vector<SolverMove>& moves)
+    {
+        if (remainingMask == 0)
+        {
+            return true;
+        }
+        
+        uint64_t key = makeKey(remainingMask, drawnCount, bottomFace);
+        uint16_t failedBudget = 0;
+        if (context.table.find(key, failedBudget) && budget <= (int)failedBudget)
+        {
+            return false;
+        }
+        
+        if (context.aborted || context.visitedStates >= context.maxStates)
+        {
+            context.aborted = true;
+            return false;
+        }
+        // 每展开1024个状态检查一次取消标志
+        if ((context.visitedStates & 1023) == 0 && context.cancelFlag != nullptr
+            && context.cancelFlag->load(std::memory_order_relaxed))
+        {
+            context.aborted = true;
+            return false;
+        }
+        ++context.visitedStates;
+        
+        int stackLeft = (int)context.stackFaces.size() - drawnCount;
+        uint64_t exposedMask = exposedCards(context, remainingMask);
+        int lowerBound = lowerBoundDraws(context, remainingMask, exposedMask, drawnCount, bottomFace);
+        if (lowerBound > budget)
+        {
+            context.table.insert(key, lowerBound > stackLeft ? DEAD_END : (uint16_t)(lowerBound - 1));
+            return false;
+        }
+        
+        // 消除与底牌点数差1的主牌区卡牌
+        if (bottomFace != FACE_NONE)
+        {
+            int neighbors[2] = { (bottomFace + 1) % FACE_COUNT, (bottomFace + FACE_COUNT - 1) % FACE_COUNT };
+            for (int face : neighbors)
+            {
+                bool freeCardTried = false;
+                for (uint64_t candidates = exposedMask & context.faceMasks[face]; candidates != 0; candidates &= candidates - 1)
+                {
+                    int index = lowestBitIndex(candidates);
+                    if ((context.coveredMasks[index] & remainingMask) == 0)
+                    {
+                        if (freeCardTried)
+                        {
+                            continue;
+                        }
+                        freeCardTried = true;
+                    }
+                    if (search(context, remainingMask & ~((uint64_t)1 << index), drawnCount, face, budget, moves))
+                    {
+                        moves.push_back({ SolverMoveType::PLAY_FIELD_CARD, context.playFieldCardIds[index] });
+                        return true;
+                    }
+                }
+            }
+        }
+        
+        // 翻开备用牌堆顶部牌
+        if (budget > 0 && stackLeft > 0)
+        {
+            if (search(context, remainingMask, drawnCount + 1, context.stackFaces[drawnCount], budget - 1, moves))
+            {
+                moves.push_back({ SolverMoveType::STACK_CARD, context.stackCardIds[drawnCount] });
+                return true;
+            }
+        }
+        
+        if (!context.aborted)
+        {
+            // 预算覆盖全部剩余备用牌时失败即为死局
+            context.table.insert(key, budget >= stackLeft ? DEAD_END : (uint16_t)budget);
+        }
+        return false;
+    }
+}
+
+SolverResult GameSolver::solve(const GameModel* gameModel, size_t maxStates, const std::atomic<bool>* cancelFlag)
+{
+    TRACE_ZONE("GameSolver::solve");
+    
+    SolverResult result;
+    result.solvable = false;
+    result.completed = false;
+    result.visitedStates = 0;
+    
+    if (gameModel == nullptr)
+    {
+        return result;
+    }
+    
+    const std::vector<int>& playFieldCardIds = gameModel->getPlayFieldCardIds();
+    const std::vector<int>& stackCardIds = gameModel->getStackCardIds();
+    if ((int)playFieldCardIds.size() > MAX_PLAY_FIELD_CARDS || (int)stackCardIds.size() > MAX_STACK_CARDS)
+    {
+        return result;
+    }
+    
+    SolverContext context;
+    context.visitedStates = 0;
+    context.maxStates = maxStates;
+    context.cancelFlag = cancelFlag;
+    context.aborted = false;
+    for (int face = 0; face < FACE_COUNT; ++face)
+    {
+        context.faceMasks[face] = 0;
+    }
+    
+    uint64_t remainingMask = 0;
+    for (size_t i = 0; i < playFieldCardIds.size(); ++i)
+    {
+        int face = toFaceIndex(gameModel->getCardFace(playFieldCardIds[i]));
+        if (face == FACE_NONE)
+        {
+            // 无效卡牌永远无法消除
+            result.completed = true;
+            return result;
+        }
+        context.faceMasks[face] |= (uint64_t)1 << i;
+        remainingMask |= (uint64_t)1 << i;
+        context.playFieldCardIds.push_back(playFieldCardIds[i]);
+    }
+    
+    // 遮挡关系只保留两端都在主牌区的（已离开主牌区的上层卡牌不再遮挡）
+    int playCount = (int)playFieldCardIds.size();
+    context.coveringMasks.assign(playCount, 0);
+    context.coveredMasks.assign(playCount, 0);
+    context.hasCovers = false;
+    std::vector<int> coveredCardIds;
+    for (int i = 0; i < playCount; ++i)
+    {
+        gameModel->collectCoveredCards(playFieldCardIds[i], coveredCardIds);
+        for (int coveredCardId : coveredCardIds)
+        {
+            auto it = std::find(playFieldCardIds.begin(), playFieldCardIds.end(), coveredCardId);
+            if (it == playFieldCardIds.end())
+            {
+                continue;
+            }
+            int j = (int)(it - playFieldCardIds.begin());
+            context.coveredMasks[i] |= (uint64_t)1 << j;
+            context.coveringMasks[j] |= (uint64_t)1 << i;
+            context.hasCovers = true;
+        }
+    }
+    
+    // 备用牌堆从底部到顶部存储，翻牌顺序为从顶部到底部
+    for (auto it = stackCardIds.rbegin(); it != stackCardIds.rend(); ++it)
+    {
+        context.stackCardIds.push_back(*it);
+        context.stackFaces.push_back(toFaceIndex(gameModel->getCardFace(*it)));
+    }
+    
+    int stackCount = (int)context.stackFaces.size();
+    context.neighborCounts.assign((stackCount + 1) * FACE_COUNT, 0);
+    for (int i = 0; i < stackCount; ++i)
+    {
+        for (int face = 0; face < FACE_COUNT; ++face)
+        {
+            uint16_t count = context.neighborCounts[i * FACE_COUNT + face];
+            int stackFace = context.stackFaces[i];
+            if (stackFace != FACE_NONE
+                && (stackFace == (face + 1) % FACE_COUNT || stackFace == (face + FACE_COUNT - 1) % FACE_COUNT))
+            {
+                context.neighborPositions[face].push_back(i);
+                ++count;
+            }
+            context.neighborCounts[(i + 1) * FACE_COUNT + face] = count;
+        }
+    }
+    
+    int bottomFace = FACE_NONE;
+    if (gameModel->getBottomCardId() != 0)
+    {
+        bottomFace = toFaceIndex(gameModel->getCardFace(gameModel->getBottomCardId()));
+    }
+    
+    // 先找到任意获胜步骤，再逐步收紧翻牌预算，直到证明不存在更短的步骤
+    int budget = (int)context.stackFaces.size();
+    std::vector<SolverMove> moves;
+    while (search(context, remainingMask, 0, bottomFace, budget, moves))
+    {
+        std::reverse(moves.begin(), moves.end());
+        result.moves.swap(moves);
+        result.solvable = true;
+        
+        int draws = (int)result.moves.size() - (int)playFieldCardIds.size();
+        moves.clear();
+        if (draws == 0)
+        {
+            break;
+        }
+        budget = draws - 1;
+    }
+    
+    result.visitedStates = context.visitedStates;
+    result.completed = !context.aborted;
+    return result;
+}
+
+bool GameSolver::isWinnable(const GameModel* gameModel)
+{
+    return solve(gameModel).solvable;
+}
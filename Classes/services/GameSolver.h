@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __GAME_SOLVER_H__
+#define __GAME_SOLVER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 前向声明
+class GameModel;
+
+/**
+ * @brief 求解步骤类型
+ */
+enum class SolverMoveType
+{
+    PLAY_FIELD_CARD,    // 点击主牌区卡牌（与底牌匹配消除）
+    STACK_CARD          // 点击备用牌堆顶部牌（替换底牌）
+};
+
+/**
+ * @brief 求解步骤
+ */
+struct SolverMove
+{
+    SolverMoveType type;    // 步骤类型
+    int cardId;             // 被点击的卡牌ID
+};
+
+/**
+ * @brief 求解结果
+ */
+struct SolverResult
+{
+    bool solvable;                  // 是否可以获胜
+    bool completed;                 // 结论是否已被证明（无解已穷举、有解时步骤已证明最短；超出状态上限或牌局超出支持范围时为false）
+    std::vector<SolverMove> moves;  // 获胜步骤（completed为true时为最短步骤）
+    size_t visitedStates;           // 展开过的状态数
+};
+
+/**
+ * @brief 牌局求解服务
+ * 纯数据层求解器，不依赖Director、视图和控制器
+ * 状态编码为64位键：主牌区剩余位图(48位) | 备用牌堆已翻张数(12位) | 底牌点数(4位)
+ * 主牌区遮挡关系按下标转成位图，卡牌可点击当且仅当遮挡它的卡牌都已不在剩余位图中，因此状态键不变
+ * 获胜步骤数 = 主牌区卡牌数 + 翻牌数，因此最短步骤即翻牌最少的步骤：
+ * 先深度优先找到任意解，再收紧翻牌预算重新搜索，置换表记录每个状态已证明失败的预算
+ */
+class GameSolver
+{
+public:
+    static const int MAX_PLAY_FIELD_CARDS = 48;         // 支持的最大主牌区卡牌数
+    static const int MAX_STACK_CARDS = 4095;            // 支持的最大备用牌堆卡牌数
+    static const size_t DEFAULT_MAX_STATES = 1 << 22;   // 默认状态上限
+    
+    /**
+     * @brief 求解牌局
+     * @param gameModel 游戏模型（只读）
+     * @param maxStates 最多展开的状态数，超出后停止并返回completed=false（已找到的解仍然保留）
+     * @param cancelFlag 取消标志（可为nullptr），其他线程置为true后搜索尽快停止，结果同超出状态上限
+     * @return 求解结果
+     */
+    static SolverResult solve(const GameModel* gameModel, size_t maxStates = DEFAULT_MAX_STATES,
+                              const std::atomic<bool>* cancelFlag = nullptr);
+    
+    /**
+     * @brief 判断牌局是否可以获胜
+     * @param gameModel 游戏模型（只读）
+     * @return true表示存在获胜步骤
+     */
+    static bool isWinnable(const GameModel* gameModel);
+
+private:
+    GameSolver() {}
+    virtual ~GameSolver() {}
+};
+
+#endif // __GAME_SOLVER_H__
@@ -0,0 +1,139 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "MoveLogVerifier.h"
+#include "GameModelFromLevelGenerator.h"
+#include "../configs/models/LevelConfig.h"
+#include "../managers/UndoManager.h"
+#include "../models/GameModel.h"
+#include "../models/MoveLog.h"
+#include "../models/UndoRecord.h"
+
+namespace
+{
+    MoveLogVerifyResult makeResult(MoveLogVerifyError error, size_t failedEntryIndex)
+    {
+        MoveLogVerifyResult result;
+        result.valid = (error == MoveLogVerifyError::NONE);
+        result.won = false;
+        result.error = error;
+        result.failedEntryIndex = failedEntryIndex;
+        result.finalMoveCount = 0;
+        return result;
+    }
+}
+
+MoveLogVerifyResult MoveLogVerifier::verify(const MoveLog& moveLog, const LevelConfig* levelConfig)
+{
+    if (levelConfig == nullptr || levelConfig->getLevelId() != moveLog.getLevelId())
+    {
+        return makeResult(MoveLogVerifyError::LEVEL_MISMATCH, 0);
+    }
+    
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig, moveLog.getSeed());
+    if (gameModel == nullptr)
+    {
+        return makeResult(MoveLogVerifyError::INVALID_DEAL, 0);
+    }
+    
+    MoveLogVerifyResult result = replay(moveLog, gameModel);
+    delete gameModel;
+    return result;
+}
+
+MoveLogVerifyResult MoveLogVerifier::replay(const MoveLog& moveLog, GameModel* gameModel)
+{
+    if (gameModel == nullptr)
+    {
+        return makeResult(MoveLogVerifyError::INVALID_DEAL, 0);
+    }
+    
+    UndoManager undoManager;
+    undoManager.init(gameModel);
+    
+    const std::vector<MoveLogEntry>& entries = moveLog.getEntries();
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const MoveLogEntry& entry = entries[i];
+        if (gameModel->getPlayFieldCardIds().empty())
+        {
+            // 获胜后弹出结算界面，不会再有操作
+            return makeResult(MoveLogVerifyError::MOVE_AFTER_VICTORY, i);
+        }
+        
+        int bottomCardId = gameModel->getBottomCardId();
+        UndoRecord record = {};
+        record.cardId = entry.cardId;
+        record.replacedCardId = bottomCardId;
+        switch (entry.action)
+        {
+            case MoveLogAction::TAP_PLAY_FIELD:
+                // 与PlayFieldController::handleCardClick相同：卡牌在主牌区且未被遮挡、存在底牌且点数相邻
+                if (!gameModel->isCardExposed(entry.cardId) || bottomCardId == 0
+                    || !gameModel->hasCard(bottomCardId) || !gameModel->canCardsMatch(entry.cardId, bottomCardId))
+                {
+                    return makeResult(MoveLogVerifyError::ILLEGAL_TAP, i);
+                }
+                record.actionType = UndoActionType::ELIMINATE_CARD;
+                record.playFieldIndex = gameModel->getPlayFieldIndex(entry.cardId);
+                break;
+            
+            case MoveLogAction::TAP_STACK:
+                // 与StackController::handleCardClick相同：只能点击顶部牌
+                if (gameModel->getStackCardIds().empty() || gameModel->getStackCardIds().back() != entry.cardId)
+                {
+                    return makeResult(MoveLogVerifyError::ILLEGAL_STACK_TAP, i);
+                }
+                record.actionType = UndoActionType::REPLACE_BOTTOM_CARD;
+                record.playFieldIndex = -1;
+                break;
+            
+            case MoveLogAction::UNDO:
+                if (!undoManager.canUndo() || !UndoManager::revertRecord(gameModel, *undoManager.getUndoRecord()))
+                {
+                    return makeResult(MoveLogVerifyError::NOTHING_TO_UNDO, i);
+                }
+                undoManager.stepBack();
+                continue;
+            
+            case MoveLogAction::REDO:
+                if (!undoManager.canRedo() || !UndoManager::applyRecord(gameModel, *undoManager.getRedoRecord()))
+                {
+                    return makeResult(MoveLogVerifyError::NOTHING_TO_REDO, i);
+                }
+                undoManager.stepForward();
+                continue;
+        }
+        
+        // 点击已校验合法，applyRecord不会失败
+        UndoManager::applyRecord(gameModel, record);
+        undoManager.pushUndoRecord(record);
+    }
+    
+    MoveLogVerifyResult result = makeResult(MoveLogVerifyError::NONE, entries.size());
+    result.won = gameModel->getPlayFieldCardIds().empty();
+    result.finalMoveCount = undoManager.getMoveCount();
+    return result;
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __MOVE_LOG_VERIFIER_H__
+#define __MOVE_LOG_VERIFIER_H__
+
+#include <cstddef>
+
+// 前向声明
+class GameModel;
+class LevelConfig;
+class MoveLog;
+
+/**
+ * @brief 校验失败原因
+ */
+enum class MoveLogVerifyError
+{
+    NONE,                   // 全部操作合法
+    LEVEL_MISMATCH,         // 关卡配置与记录的关卡ID不符
+    INVALID_DEAL,           // 无法生成牌局
+    ILLEGAL_TAP,            // 点击的卡牌不在主牌区、被遮挡或与底牌点数不相邻
+    ILLEGAL_STACK_TAP,      // 点击的不是备用牌堆顶部牌
+    NOTHING_TO_UNDO,        // 没有可回退的步骤
+    NOTHING_TO_REDO,        // 没有可重做的步骤
+    MOVE_AFTER_VICTORY      // 主牌区清空后仍有操作
+};
+
+/**
+ * @brief 校验结果
+ */
+struct MoveLogVerifyResult
+{
+    bool valid;                 // 全部操作是否合法
+    bool won;                   // 重放结束时主牌区是否已清空
+    MoveLogVerifyError error;   // 失败原因
+    size_t failedEntryIndex;    // 第一条非法操作的下标（合法时为操作总数）
+    size_t finalMoveCount;      // 重放结束时的有效步数（不含已回退的步骤）
+};
+
+/**
+ * @brief 操作记录校验服务（服务器端重放，不依赖引擎和视图）
+ * 按记录中的种子重新生成牌局，逐条重放操作，规则与PlayFieldController/StackController::handleCardClick
+ * 及GameController的回退/重做一致：点数相邻规则与CardModel::canMatchWith相同，撤销记录通过UndoManager维护
+ */
+class MoveLogVerifier
+{
+public:
+    /**
+     * @brief 按关卡配置和记录中的种子生成牌局并重放
+     * @param moveLog 操作记录（不可信输入）
+     * @param levelConfig 记录中关卡ID对应的关卡配置
+     * @return 校验结果
+     */
+    static MoveLogVerifyResult verify(const MoveLog& moveLog, const LevelConfig* levelConfig);
+    
+    /**
+     * @brief 从给定的开局牌局重放
+     * @param moveLog 操作记录
+     * @param gameModel 开局牌局（重放后为结束时的牌局）
+     * @return 校验结果
+     */
+    static MoveLogVerifyResult replay(const MoveLog& moveLog, GameModel* gameModel);
+
+private:
+    MoveLogVerifier() {}
+    virtual ~MoveLogVerifier() {}
+};
+
+#endif // __MOVE_LOG_VERIFIER_H__
@@ -0,0 +1,186 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "PlayFieldLayoutGenerator.h"
+#include <algorithm>
+
+void PlayFieldLayoutGenerator::generateLayout(const LevelConfig* levelConfig, PlayFieldLayout& layout)
+{
+    if (levelConfig == nullptr)
+    {
+        layout.slots.clear();
+        layout.overlapGroupCount = 0;
+        return;
+    }
+    generateLayout(levelConfig->getPlayFieldLayout(), (int)levelConfig->getPlayFieldCards().size(),
+                   levelConfig->getPlayFieldCovers(), layout);
+}
+
+void PlayFieldLayoutGenerator::generateLayout(const PlayFieldLayoutConfig& layoutConfig, int cardCount,
+                                              const std::vector<PlayFieldCoverConfig>& covers, PlayFieldLayout& layout)
+{
+    PlayFieldSlot emptySlot = { 0.0f, 0.0f, 0, -1 };
+    layout.slots.assign(std::max(0, cardCount), emptySlot);
+    
+    switch (layoutConfig.type)
+    {
+        case PlayFieldLayoutType::GRID:
+            placeGrid(layoutConfig, layout.slots);
+            break;
+        
+        case PlayFieldLayoutType::PYRAMID:
+            placePyramid(layoutConfig, layout.slots);
+            break;
+        
+        case PlayFieldLayoutType::CUSTOM:
+            for (size_t i = 0; i < layout.slots.size() && i < layoutConfig.positions.size(); ++i)
+            {
+                layout.slots[i].x = layoutConfig.positions[i].x;
+                layout.slots[i].y = layoutConfig.positions[i].y;
+            }
+            break;
+    }
+    
+    assignLayers(covers, layout.slots);
+    layout.overlapGroupCount = assignOverlapGroups(layout.slots);
+}
+
+void PlayFieldLayoutGenerator::placeGrid(const PlayFieldLayoutConfig& layoutConfig, std::vector<PlayFieldSlot>& slots)
+{
+    // 逐行从左到右，整体居中（最后一行不满时左对齐）
+    int count = (int)slots.size();
+    int cols = std::max(1, std::min(layoutConfig.columns, std::max(1, count)));
+    int rows = (count + cols - 1) / cols;
+    for (int i = 0; i < count; ++i)
+    {
+        int row = i / cols;
+        int col = i % cols;
+        slots[i].x = (col - (cols - 1) * 0.5f) * layoutConfig.spacingX;
+        slots[i].y = ((rows - 1) * 0.5f - row) * layoutConfig.spacingY;
+    }
+}
+
+void PlayFieldLayoutGenerator::placePyramid(const PlayFieldLayoutConfig& layoutConfig, std::vector<PlayFieldSlot>& slots)
+{
+    // 首行宽度取能放下所有卡牌的最小值，之后每行少一张
+    int count = (int)slots.size();
+    int width = 1;
+    while (width * (width + 1) / 2 < count)
+    {
+        ++width;
+    }
+    int rows = 0;
+    int placed = 0;
+    while (placed < count)
+    {
+        placed += width - rows;
+        ++rows;
+    }
+    
+    int index = 0;
+    for (int row = 0; row < rows; ++row)
+    {
+        int rowWidth = width - row;
+        for (int col = 0; col < rowWidth && index < count; ++col, ++index)
+        {
+            slots[index].x = (col - (rowWidth - 1) * 0.5f) * layoutConfig.spacingX;
+            slots[index].y = ((rows - 1) * 0.5f - row) * layoutConfig.spacingY;
+        }
+    }
+}
+
+void PlayFieldLayoutGenerator::assignLayers(const std::vector<PlayFieldCoverConfig>& covers, std::vector<PlayFieldSlot>& slots)
+{
+    // 从不压住任何牌的位置开始按拓扑序推进：上层卡牌的层级比它压住的所有卡牌都高
+    int count = (int)slots.size();
+    std::vector<int> remainingCovered(count, 0);
+    std::vector<std::vector<int> > coveringSlots(count);
+    for (const PlayFieldCoverConfig& cover : covers)
+    {
+        if (cover.coverIndex < 0 || cover.coverIndex >= count || cover.coveredIndex < 0 || cover.coveredIndex >= count
+            || cover.coverIndex == cover.coveredIndex)
+        {
+            continue;
+        }
+        ++remainingCovered[cover.coverIndex];
+        coveringSlots[cover.coveredIndex].push_back(cover.coverIndex);
+    }
+    
+    std::vector<int> ready;
+    for (int i = 0; i < count; ++i)
+    {
+        slots[i].layer = 0;
+        if (remainingCovered[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+    while (!ready.empty())
+    {
+        int index = ready.back();
+        ready.pop_back();
+        for (int coverIndex : coveringSlots[index])
+        {
+            slots[coverIndex].layer = std::max(slots[coverIndex].layer, slots[index].layer + 1);
+            if (--remainingCovered[coverIndex] == 0)
+            {
+                ready.push_back(coverIndex);
+            }
+        }
+    }
+}
+
+int PlayFieldLayoutGenerator::assignOverlapGroups(std::vector<PlayFieldSlot>& slots)
+{
+    // 按坐标排序后相邻且坐标相同的位置归为一组
+    std::vector<int> order(slots.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = (int)i;
+        slots[i].overlapGroup = -1;
+    }
+    std::sort(order.begin(), order.end(), [&slots](int a, int b) {
+        return slots[a].x != slots[b].x ? slots[a].x < slots[b].x : slots[a].y < slots[b].y;
+    });
+    
+    int groupCount = 0;
+    for (size_t begin = 0; begin < order.size(); )
+    {
+        size_t end = begin + 1;
+        while (end < order.size() && slots[order[end]].x == slots[order[begin]].x && slots[order[end]].y == slots[order[begin]].y)
+        {
+            ++end;
+        }
+        if (end - begin > 1)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                slots[order[i]].overlapGroup = groupCount;
+            }
+            ++groupCount;
+        }
+        begin = end;
+    }
+    return groupCount;
+}
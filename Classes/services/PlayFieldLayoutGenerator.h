@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __PLAY_FIELD_LAYOUT_GENERATOR_H__
+#define __PLAY_FIELD_LAYOUT_GENERATOR_H__
+
+#include "../configs/models/LevelConfig.h"
+#include <vector>
+
+/**
+ * @brief 主牌区一个位置的布局结果
+ */
+struct PlayFieldSlot
+{
+    float x;                // 卡牌中心相对主牌区中心的横坐标
+    float y;                // 卡牌中心相对主牌区中心的纵坐标（向上为正）
+    int layer;              // 绘制层级：不压住其他牌为0，否则比所压卡牌的最高层级高1
+    int overlapGroup;       // 坐标完全相同的位置共用的分组下标（上层卡牌完全挡住下层），不与其他位置重合时为-1
+};
+
+/**
+ * @brief 主牌区布局（按主牌区位置下标）
+ */
+struct PlayFieldLayout
+{
+    std::vector<PlayFieldSlot> slots;
+    int overlapGroupCount;
+    
+    PlayFieldLayout() : overlapGroupCount(0) {}
+};
+
+/**
+ * @brief 主牌区布局生成服务
+ * 把关卡配置中的布局描述（网格、金字塔、自定义坐标）和遮挡关系展开为每个位置的坐标、层级和重合分组
+ * 不依赖引擎，视图只需加上主牌区中心坐标
+ */
+class PlayFieldLayoutGenerator
+{
+public:
+    /**
+     * @brief 按关卡配置生成主牌区布局
+     * @param levelConfig 关卡配置
+     * @param layout 输出布局（位置数与主牌区卡牌数相同）
+     */
+    static void generateLayout(const LevelConfig* levelConfig, PlayFieldLayout& layout);
+    
+    /**
+     * @brief 按布局配置生成指定数量位置的布局
+     * @param layoutConfig 布局配置（CUSTOM布局坐标不足的位置放在原点）
+     * @param cardCount 位置数量
+     * @param covers 遮挡关系（用于计算层级，越界的关系被忽略）
+     * @param layout 输出布局
+     */
+    static void generateLayout(const PlayFieldLayoutConfig& layoutConfig, int cardCount,
+                               const std::vector<PlayFieldCoverConfig>& covers, PlayFieldLayout& layout);
+
+private:
+    PlayFieldLayoutGenerator() {}
+    virtual ~PlayFieldLayoutGenerator() {}
+    
+    static void placeGrid(const PlayFieldLayoutConfig& layoutConfig, std::vector<PlayFieldSlot>& slots);
+    static void placePyramid(const PlayFieldLayoutConfig& layoutConfig, std::vector<PlayFieldSlot>& slots);
+    static void assignLayers(const std::vector<PlayFieldCoverConfig>& covers, std::vector<PlayFieldSlot>& slots);
+    static int assignOverlapGroups(std::vector<PlayFieldSlot>& slots);
+};
+
+#endif // __PLAY_FIELD_LAYOUT_GENERATOR_H__
@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "RenderOnDemandService.h"
+#include "base/CCDirector.h"
+#include "base/CCEventDispatcher.h"
+#include "base/CCEventListenerKeyboard.h"
+#include "base/CCEventListenerMouse.h"
+#include "base/CCEventListenerTouch.h"
+#include "2d/CCActionManager.h"
+
+USING_NS_CC;
+
+namespace
+{
+    // 输入监听的固定优先级：先于场景内的监听执行，且不吞没事件
+    const int INPUT_LISTENER_PRIORITY = -1;
+    
+    bool enabled = false;
+    bool installed = false;
+    bool idle = false;
+    int quietFrames = 0;
+    int wakeLockCount = 0;
+    
+    /**
+     * @brief 每帧绘制后更新安静帧计数，满足条件时停止出帧
+     */
+    void onAfterDraw()
+    {
+        // 能走到这里说明正在出帧（包括回到前台后由AppDelegate恢复的情况）
+        idle = false;
+        if (!enabled)
+        {
+            return;
+        }
+        
+        Director* director = Director::getInstance();
+        if (wakeLockCount > 0 || director->getActionManager()->getNumberOfRunningActions() > 0)
+        {
+            quietFrames = 0;
+            return;
+        }
+        
+        ++quietFrames;
+        if (quietFrames >= RenderOnDemandService::IDLE_FRAME_COUNT)
+        {
+            quietFrames = 0;
+            idle = true;
+            director->stopAnimation();
+        }
+    }
+    
+    /**
+     * @brief 注册帧监听和唤醒用的输入监听
+     * 鼠标移动不唤醒：没有悬停效果，桌面端按下/抬起会同时转换成触摸事件
+     */
+    void install()
+    {
+        Director* director = Director::getInstance();
+        EventDispatcher* dispatcher = director->getEventDispatcher();
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [](EventCustom*) {
+            onAfterDraw();
+        });
+        dispatcher->addCustomEventListener(Director::EVENT_PROJECTION_CHANGED, [](EventCustom*) {
+            RenderOnDemandService::requestRedraw();
+        });
+        
+        auto touchListener = EventListenerTouchAllAtOnce::create();
+        auto onTouches = [](const std::vector<Touch*>&, Event*) {
+            RenderOnDemandService::requestRedraw();
+        };
+        touchListener->onTouchesBegan = onTouches;
+        touchListener->onTouchesMoved = onTouches;
+        touchListener->onTouchesEnded = onTouches;
+        touchListener->onTouchesCancelled = onTouches;
+        dispatcher->addEventListenerWithFixedPriority(touchListener, INPUT_LISTENER_PRIORITY);
+        
+        auto mouseListener = EventListenerMouse::create();
+        auto onMouse = [](EventMouse*) {
+            RenderOnDemandService::requestRedraw();
+        };
+        mouseListener->onMouseDown = onMouse;
+        mouseListener->onMouseUp = onMouse;
+        mouseListener->onMouseScroll = onMouse;
+        dispatcher->addEventListenerWithFixedPriority(mouseListener, INPUT_LISTENER_PRIORITY);
+        
+        auto keyboardListener = EventListenerKeyboard::create();
+        auto onKey = [](EventKeyboard::KeyCode, Event*) {
+            RenderOnDemandService::requestRedraw();
+        };
+        keyboardListener->onKeyPressed = onKey;
+        keyboardListener->onKeyReleased = onKey;
+        dispatcher->addEventListenerWithFixedPriority(keyboardListener, INPUT_LISTENER_PRIORITY);
+    }
+}
+
+void RenderOnDemandService::setEnabled(bool value)
+{
+    if (value && !installed)
+    {
+        installed = true;
+        install();
+    }
+    enabled = value;
+    if (!enabled)
+    {
+        requestRedraw();
+    }
+}
+
+bool RenderOnDemandService::isEnabled()
+{
+    return enabled;
+}
+
+bool RenderOnDemandService::isIdle()
+{
+    return idle;
+}
+
+void RenderOnDemandService::requestRedraw()
+{
+    quietFrames = 0;
+    if (idle)
+    {
+        // startAnimation会把下一帧的dt置0，空闲的时长不会让动作跳帧
+        idle = false;
+        Director::getInstance()->startAnimation();
+    }
+}
+
+void RenderOnDemandService::acquireWakeLock()
+{
+    ++wakeLockCount;
+    requestRedraw();
+}
+
+void RenderOnDemandService::releaseWakeLock()
+{
+    if (wakeLockCount > 0)
+    {
+        --wakeLockCount;
+    }
+}
@@ -0,0 +1,79 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __RENDER_ON_DEMAND_SERVICE_H__
+#define __RENDER_ON_DEMAND_SERVICE_H__
+
+/**
+ * @brief 按需渲染服务
+ * 开启后，在AFTER_DRAW时检查本帧是否仍有动作、唤醒锁；连续IDLE_FRAME_COUNT帧都没有时调用Director::stopAnimation，
+ * 主循环不再执行drawScene（不更新调度器、不遍历场景、不提交、不交换缓冲区），屏幕保持最后一帧
+ * 触摸、鼠标按键/滚轮、键盘和投影变化会重新startAnimation；逻辑上需要持续出帧的模块（移动动画、异步加载、
+ * 后台提示搜索）在运行期间持有唤醒锁
+ * 所有接口只能在主线程调用
+ */
+class RenderOnDemandService
+{
+public:
+    /**
+     * @brief 进入空闲前需要连续安静的帧数（留出余量让切换场景等延迟一帧的操作完成绘制）
+     */
+    static const int IDLE_FRAME_COUNT = 3;
+    
+    /**
+     * @brief 开启或关闭按需渲染（第一次开启时注册监听，关闭时若处于空闲立即恢复出帧）
+     */
+    static void setEnabled(bool value);
+    
+    /**
+     * @brief 是否开启了按需渲染
+     */
+    static bool isEnabled();
+    
+    /**
+     * @brief 当前是否因空闲停止了出帧
+     */
+    static bool isIdle();
+    
+    /**
+     * @brief 请求重绘：空闲时恢复出帧，并重新开始安静帧计数
+     */
+    static void requestRedraw();
+    
+    /**
+     * @brief 获取唤醒锁：持有期间不会进入空闲（获取时会请求重绘）
+     */
+    static void acquireWakeLock();
+    
+    /**
+     * @brief 释放唤醒锁（必须与acquireWakeLock配对）
+     */
+    static void releaseWakeLock();
+
+private:
+    RenderOnDemandService() {}
+    virtual ~RenderOnDemandService() {}
+};
+
+#endif // __RENDER_ON_DEMAND_SERVICE_H__
@@ -0,0 +1,152 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TraceService.h"
+#include "../utils/TraceRecorder.h"
+#include "base/CCConsole.h"
+#include "base/CCDirector.h"
+#include "base/CCEventDispatcher.h"
+#include "platform/CCFileUtils.h"
+
+USING_NS_CC;
+
+namespace
+{
+    // 以下时间戳只在主线程读写，0表示本帧尚未开始该阶段
+    uint64_t frameBeginNs = 0;
+    uint64_t updateBeginNs = 0;
+    uint64_t visitBeginNs = 0;
+    uint64_t renderBeginNs = 0;
+    
+    bool installed = false;
+    std::string traceFilePath;
+    
+    /**
+     * @brief 结束一个阶段并写入区段
+     */
+    void endPhase(const char* name, uint64_t& beginNs)
+    {
+        if (beginNs != 0 && TraceRecorder::isEnabled())
+        {
+            TraceRecorder::record(name, beginNs, TraceRecorder::now());
+        }
+        beginNs = 0;
+    }
+    
+    /**
+     * @brief 注册帧阶段监听
+     * drawScene依次派发BEFORE_UPDATE、AFTER_UPDATE、BEFORE_DRAW、AFTER_VISIT、AFTER_DRAW（暂停时没有UPDATE事件）
+     */
+    void addFrameListeners(EventDispatcher* dispatcher)
+    {
+        dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [](EventCustom*) {
+            uint64_t now = TraceRecorder::now();
+            frameBeginNs = now;
+            updateBeginNs = now;
+        });
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [](EventCustom*) {
+            endPhase("Scheduler::update", updateBeginNs);
+        });
+        dispatcher->addCustomEventListener(Director::EVENT_BEFORE_DRAW, [](EventCustom*) {
+            uint64_t now = TraceRecorder::now();
+            if (frameBeginNs == 0)
+            {
+                frameBeginNs = now;
+            }
+            visitBeginNs = now;
+        });
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [](EventCustom*) {
+            endPhase("Scene::visit", visitBeginNs);
+            renderBeginNs = TraceRecorder::now();
+        });
+        dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [](EventCustom*) {
+            // AFTER_VISIT到AFTER_DRAW之间主要是renderer->render()，另含帧率统计
+            endPhase("Renderer::render", renderBeginNs);
+            endPhase("Director::drawScene", frameBeginNs);
+        });
+    }
+    
+    /**
+     * @brief 注册控制台命令（命令在控制台线程执行，只访问线程安全的TraceRecorder和已确定的导出路径）
+     */
+    void addConsoleCommand(Console* console)
+    {
+        console->addCommand(Console::Command("trace", "Frame-phase trace zones. Args: [-h | help | on | off | clear | dump | ]",
+                                             [](int fd, const std::string& args) {
+            Console::Utility::mydprintf(fd, "trace recording is %s\n", TraceRecorder::isEnabled() ? "on" : "off");
+        }));
+        console->addSubCommand("trace", Console::Command("on", "Start recording trace zones.", [](int fd, const std::string& args) {
+            TraceRecorder::setEnabled(true);
+            Console::Utility::mydprintf(fd, "trace recording on\n");
+        }));
+        console->addSubCommand("trace", Console::Command("off", "Stop recording trace zones (recorded zones are kept).", [](int fd, const std::string& args) {
+            TraceRecorder::setEnabled(false);
+            Console::Utility::mydprintf(fd, "trace recording off\n");
+        }));
+        console->addSubCommand("trace", Console::Command("clear", "Discard recorded trace zones.", [](int fd, const std::string& args) {
+            TraceRecorder::clear();
+            Console::Utility::mydprintf(fd, "trace cleared\n");
+        }));
+        console->addSubCommand("trace", Console::Command("dump", "Write recorded zones as Chrome trace JSON to the writable path.", [](int fd, const std::string& args) {
+            if (TraceService::dump())
+            {
+                Console::Utility::mydprintf(fd, "trace written to %s\n", traceFilePath.c_str());
+            }
+            else
+            {
+                Console::Utility::mydprintf(fd, "failed to write %s\n", traceFilePath.c_str());
+            }
+        }));
+    }
+}
+
+void TraceService::install()
+{
+    if (installed)
+    {
+        return;
+    }
+    installed = true;
+    
+    traceFilePath = FileUtils::getInstance()->getWritablePath() + "trace.json";
+    TraceRecorder::setThreadName("main");
+    
+    Director* director = Director::getInstance();
+    addFrameListeners(director->getEventDispatcher());
+    addConsoleCommand(director->getConsole());
+}
+
+const std::string& TraceService::getTraceFilePath()
+{
+    return traceFilePath;
+}
+
+bool TraceService::dump()
+{
+    if (traceFilePath.empty())
+    {
+        return false;
+    }
+    return TraceRecorder::writeChromeTrace(traceFilePath);
+}
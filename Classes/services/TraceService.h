@@ -0,0 +1,60 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __TRACE_SERVICE_H__
+#define __TRACE_SERVICE_H__
+
+#include <string>
+
+/**
+ * @brief 追踪服务
+ * 通过Director事件记录每帧的Director::drawScene、Scheduler::update、Scene::visit和Renderer::render区段，
+ * 并注册控制台命令trace（on/off/clear/dump），dump把所有线程的区段导出为Chrome Trace JSON写入可写目录
+ * 游戏逻辑中的区段由TRACE_ZONE直接记录，不经过本服务
+ */
+class TraceService
+{
+public:
+    /**
+     * @brief 安装帧阶段监听和控制台命令（在主线程、Director创建后调用一次）
+     */
+    static void install();
+    
+    /**
+     * @brief 导出文件路径（可写目录下的trace.json）
+     */
+    static const std::string& getTraceFilePath();
+    
+    /**
+     * @brief 导出当前记录到getTraceFilePath()
+     * @return 写入是否成功
+     */
+    static bool dump();
+
+private:
+    TraceService() {}
+    virtual ~TraceService() {}
+};
+
+#endif // __TRACE_SERVICE_H__
@@ -24,22 +24,15 @@
 
 #include "CommonUtils.h"
 #include "../models/CardModel.h"
-#include <cstdlib>
-#include <ctime>
 
 int CommonUtils::randomInt(int min, int max)
 {
-    if (min > max)
-    {
-        std::swap(min, max);
-    }
-    static bool seeded = false;
-    if (!seeded)
-    {
-        srand((unsigned int)time(nullptr));
-        seeded = true;
-    }
-    return min + rand() % (max - min + 1);
+    return RandomGenerator::getThreadDefault().nextInt(min, max);
+}
+
+void CommonUtils::setRandomSeed(uint64_t seed)
+{
+    RandomGenerator::getThreadDefault().setSeed(seed);
 }
 
 CardModel* CommonUtils::cloneCardModel(const CardModel* src)
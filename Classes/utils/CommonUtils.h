@@ -25,8 +25,13 @@
 #ifndef __COMMON_UTILS_H__
 #define __COMMON_UTILS_H__
 
+#ifndef GAME_HEADLESS
 #include "cocos2d.h"
+#endif
 #include "../configs/models/CardResConfig.h"
+#include "RandomGenerator.h"
+#include <utility>
+#include <vector>
 
 /**
  * @brief 通用工具类
@@ -36,7 +41,8 @@ class CommonUtils
 {
 public:
     /**
-     * @brief 生成随机整数
+     * @brief 生成随机整数（使用当前线程的默认生成器，线程安全、无模偏差）
+     * 需要可复现的结果时应持有自己的RandomGenerator
      * @param min 最小值
      * @param max 最大值
      * @return 随机数
@@ -44,12 +50,18 @@ public:
     static int randomInt(int min, int max);
     
     /**
-     * @brief 打乱数组顺序
+     * @brief 打乱数组顺序（使用当前线程的默认生成器）
      * @param vec 要打乱的数组
      */
     template<typename T>
     static void shuffleVector(std::vector<T>& vec);
     
+    /**
+     * @brief 设置当前线程默认生成器的种子
+     * @param seed 随机种子
+     */
+    static void setRandomSeed(uint64_t seed);
+    
     /**
      * @brief 深拷贝CardModel
      * @param src 源卡牌
@@ -61,11 +73,7 @@ public:
 template<typename T>
 void CommonUtils::shuffleVector(std::vector<T>& vec)
 {
-    for (size_t i = vec.size() - 1; i > 0; --i)
-    {
-        int j = randomInt(0, (int)i);
-        std::swap(vec[i], vec[j]);
-    }
+    RandomGenerator::getThreadDefault().shuffle(vec);
 }
 
 #endif // __COMMON_UTILS_H__
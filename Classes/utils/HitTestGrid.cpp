@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "HitTestGrid.h"
+#include <algorithm>
+#include <cmath>
+
+HitTestGrid::HitTestGrid(float cellSize)
+: _cellSize(cellSize > 0.0f ? cellSize : 256.0f)
+, _arrivalCounter(0)
+{
+}
+
+void HitTestGrid::setCellSize(float cellSize)
+{
+    if (cellSize <= 0.0f || cellSize == _cellSize)
+    {
+        return;
+    }
+    _cellSize = cellSize;
+    _entries.clear();
+    _cells.clear();
+}
+
+int HitTestGrid::toCell(float value) const
+{
+    return (int)std::floor(value / _cellSize);
+}
+
+void HitTestGrid::insert(int id, float minX, float minY, float width, float height, int zOrder)
+{
+    if (id < 0)
+    {
+        return;
+    }
+    
+    remove(id);
+    if (id >= (int)_entries.size())
+    {
+        Entry empty = {};
+        _entries.resize((size_t)id + 1, empty);
+    }
+    
+    Entry& entry = _entries[id];
+    entry.minX = minX;
+    entry.minY = minY;
+    entry.maxX = minX + width;
+    entry.maxY = minY + height;
+    entry.zOrder = zOrder;
+    entry.arrival = ++_arrivalCounter;
+    entry.minCellX = toCell(entry.minX);
+    entry.minCellY = toCell(entry.minY);
+    entry.maxCellX = toCell(entry.maxX);
+    entry.maxCellY = toCell(entry.maxY);
+    entry.active = true;
+    
+    // 一张卡牌通常只覆盖2~4个格子
+    for (int cellY = entry.minCellY; cellY <= entry.maxCellY; ++cellY)
+    {
+        for (int cellX = entry.minCellX; cellX <= entry.maxCellX; ++cellX)
+        {
+            _cells[getCellKey(cellX, cellY)].push_back(id);
+        }
+    }
+}
+
+void HitTestGrid::remove(int id)
+{
+    if (!contains(id))
+    {
+        return;
+    }
+    
+    Entry& entry = _entries[id];
+    for (int cellY = entry.minCellY; cellY <= entry.maxCellY; ++cellY)
+    {
+        for (int cellX = entry.minCellX; cellX <= entry.maxCellX; ++cellX)
+        {
+            auto it = _cells.find(getCellKey(cellX, cellY));
+            if (it == _cells.end())
+            {
+                continue;
+            }
+            // 格子内顺序无关，与末尾交换后删除
+            std::vector<int>& ids = it->second;
+            auto idIt = std::find(ids.begin(), ids.end(), id);
+            if (idIt != ids.end())
+            {
+                *idIt = ids.back();
+                ids.pop_back();
+            }
+        }
+    }
+    entry.active = false;
+}
+
+int HitTestGrid::queryTopmost(float x, float y) const
+{
+    auto it = _cells.find(getCellKey(toCell(x), toCell(y)));
+    if (it == _cells.end())
+    {
+        return -1;
+    }
+    
+    int topId = -1;
+    const Entry* top = nullptr;
+    for (int id : it->second)
+    {
+        const Entry& entry = _entries[id];
+        if (x < entry.minX || x > entry.maxX || y < entry.minY || y > entry.maxY)
+        {
+            continue;
+        }
+        if (top == nullptr || entry.zOrder > top->zOrder
+            || (entry.zOrder == top->zOrder && entry.arrival > top->arrival))
+        {
+            top = &entry;
+            topId = id;
+        }
+    }
+    return topId;
+}
+
+void HitTestGrid::clear()
+{
+    for (Entry& entry : _entries)
+    {
+        entry.active = false;
+    }
+    for (auto& pair : _cells)
+    {
+        pair.second.clear();
+    }
+}
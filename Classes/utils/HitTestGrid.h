@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __HIT_TEST_GRID_H__
+#define __HIT_TEST_GRID_H__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 点击检测均匀网格
+ * 把矩形按覆盖的格子登记，查询时只检查触摸点所在格子中的矩形，耗时与牌堆大小无关
+ * 重叠时返回最上层的矩形：层级（zOrder）高者优先，层级相同则后加入者优先（与cocos2d节点绘制顺序一致）
+ * 不依赖引擎，坐标为调用方节点的本地坐标
+ */
+class HitTestGrid
+{
+public:
+    /**
+     * @brief 构造
+     * @param cellSize 格子边长（通常取卡牌的较长边）
+     */
+    explicit HitTestGrid(float cellSize = 256.0f);
+    
+    /**
+     * @brief 设置格子边长（会清空已登记的矩形）
+     */
+    void setCellSize(float cellSize);
+    
+    /**
+     * @brief 登记或更新矩形（已存在时先移除旧位置；重新加入视为最后加入）
+     * @param id 矩形ID（非负，通常为卡牌ID）
+     * @param minX 左边界
+     * @param minY 下边界
+     * @param width 宽度
+     * @param height 高度
+     * @param zOrder 层级
+     */
+    void insert(int id, float minX, float minY, float width, float height, int zOrder = 0);
+    
+    /**
+     * @brief 移除矩形（不存在时忽略）
+     */
+    void remove(int id);
+    
+    /**
+     * @brief 是否已登记
+     */
+    bool contains(int id) const { return id >= 0 && id < (int)_entries.size() && _entries[id].active; }
+    
+    /**
+     * @brief 查询包含该点的最上层矩形
+     * @return 矩形ID，没有时返回-1
+     */
+    int queryTopmost(float x, float y) const;
+    
+    /**
+     * @brief 清空所有矩形（保留已分配的存储）
+     */
+    void clear();
+
+private:
+    /**
+     * @brief 已登记的矩形
+     */
+    struct Entry
+    {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+        int zOrder;
+        uint32_t arrival;       // 加入顺序
+        int minCellX;           // 覆盖的格子范围
+        int minCellY;
+        int maxCellX;
+        int maxCellY;
+        bool active;
+    };
+    
+    int toCell(float value) const;
+    static int64_t getCellKey(int cellX, int cellY) { return ((int64_t)cellX << 32) ^ (uint32_t)cellY; }
+    
+    float _cellSize;                                            // 格子边长
+    uint32_t _arrivalCounter;                                   // 加入顺序计数
+    std::vector<Entry> _entries;                                // 矩形（下标为ID）
+    std::unordered_map<int64_t, std::vector<int>> _cells;       // 格子 -> 覆盖该格子的矩形ID
+};
+
+#endif // __HIT_TEST_GRID_H__
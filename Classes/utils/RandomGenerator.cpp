@@ -0,0 +1,157 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "RandomGenerator.h"
+#include <atomic>
+#include <ctime>
+
+namespace
+{
+    inline uint64_t rotateLeft(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+}
+
+RandomGenerator::RandomGenerator(uint64_t seed)
+{
+    setSeed(seed);
+}
+
+void RandomGenerator::setSeed(uint64_t seed)
+{
+    // 以splitmix64序列填充状态，保证状态不全为0
+    for (int i = 0; i < 4; ++i)
+    {
+        _state[i] = mixSeed(seed + (uint64_t)i * 0x9E3779B97F4A7C15ULL);
+    }
+}
+
+uint64_t RandomGenerator::next()
+{
+    uint64_t result = rotateLeft(_state[1] * 5, 7) * 9;
+    uint64_t t = _state[1] << 17;
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotateLeft(_state[3], 45);
+    return result;
+}
+
+uint32_t RandomGenerator::nextBelow(uint32_t bound)
+{
+    if (bound == 0)
+    {
+        return 0;
+    }
+    
+    // Lemire乘法取高位，落入低位余量区间时重新采样以消除偏差
+    uint64_t product = (next() >> 32) * (uint64_t)bound;
+    uint32_t low = (uint32_t)product;
+    if (low < bound)
+    {
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold)
+        {
+            product = (next() >> 32) * (uint64_t)bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+int RandomGenerator::nextInt(int min, int max)
+{
+    if (min > max)
+    {
+        std::swap(min, max);
+    }
+    uint32_t span = (uint32_t)((int64_t)max - min) + 1;
+    if (span == 0)
+    {
+        // 覆盖整个int范围
+        return (int)(uint32_t)(next() >> 32);
+    }
+    return (int)((int64_t)min + nextBelow(span));
+}
+
+float RandomGenerator::nextFloat()
+{
+    return (float)(next() >> 40) * (1.0f / 16777216.0f);
+}
+
+bool RandomGenerator::nextBool(float probability)
+{
+    return nextFloat() < probability;
+}
+
+void RandomGenerator::jump()
+{
+    static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+    
+    uint64_t state[4] = { 0, 0, 0, 0 };
+    for (uint64_t jump : JUMP)
+    {
+        for (int bit = 0; bit < 64; ++bit)
+        {
+            if (jump & (1ULL << bit))
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    state[i] ^= _state[i];
+                }
+            }
+            next();
+        }
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        _state[i] = state[i];
+    }
+}
+
+RandomGenerator RandomGenerator::split()
+{
+    RandomGenerator child = *this;
+    jump();
+    return child;
+}
+
+uint64_t RandomGenerator::mixSeed(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+RandomGenerator& RandomGenerator::getThreadDefault()
+{
+    static std::atomic<uint64_t> threadCounter(0);
+    thread_local RandomGenerator generator(mixSeed((uint64_t)time(nullptr)) ^ mixSeed(threadCounter.fetch_add(1)));
+    return generator;
+}
@@ -0,0 +1,123 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __RANDOM_GENERATOR_H__
+#define __RANDOM_GENERATOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 可复现、可拆分的伪随机数生成器（xoshiro256**）
+ * 相同种子在任何平台、任何线程上产生完全相同的序列
+ * 对象本身不加锁，每个线程或每局牌局各持有一个实例
+ * 并行生成时可用split()拆出互不重叠的子序列（每段2^128个数）
+ */
+class RandomGenerator
+{
+public:
+    /**
+     * @brief 用种子构造（种子经splitmix64展开为256位状态）
+     * @param seed 随机种子
+     */
+    explicit RandomGenerator(uint64_t seed = 0);
+    
+    /**
+     * @brief 重新设置种子
+     * @param seed 随机种子
+     */
+    void setSeed(uint64_t seed);
+    
+    /**
+     * @brief 生成64位随机数
+     */
+    uint64_t next();
+    
+    /**
+     * @brief 生成[0, bound)内均匀分布的随机整数（无模偏差）
+     * @param bound 上界，为0时返回0
+     */
+    uint32_t nextBelow(uint32_t bound);
+    
+    /**
+     * @brief 生成[min, max]内均匀分布的随机整数，min大于max时自动交换
+     */
+    int nextInt(int min, int max);
+    
+    /**
+     * @brief 生成[0, 1)内的随机浮点数
+     */
+    float nextFloat();
+    
+    /**
+     * @brief 以probability的概率返回true
+     */
+    bool nextBool(float probability);
+    
+    /**
+     * @brief 将序列向前推进2^128个数
+     */
+    void jump();
+    
+    /**
+     * @brief 拆分出一个子生成器：子生成器沿用当前序列，自身jump()到下一段
+     * 依次拆分得到的生成器互不重叠，可分给各工作线程
+     */
+    RandomGenerator split();
+    
+    /**
+     * @brief 打乱数组顺序（Fisher-Yates）
+     * @param vec 要打乱的数组
+     */
+    template<typename T>
+    void shuffle(std::vector<T>& vec);
+    
+    /**
+     * @brief splitmix64混合函数，用于从一个种子推导出多个互不相关的种子
+     */
+    static uint64_t mixSeed(uint64_t value);
+    
+    /**
+     * @brief 获取当前线程的默认生成器（首次使用时以时间和线程序号播种）
+     */
+    static RandomGenerator& getThreadDefault();
+
+private:
+    uint64_t _state[4];     // xoshiro256**状态
+};
+
+template<typename T>
+void RandomGenerator::shuffle(std::vector<T>& vec)
+{
+    for (size_t i = vec.size(); i > 1; --i)
+    {
+        size_t j = nextBelow((uint32_t)i);
+        std::swap(vec[i - 1], vec[j]);
+    }
+}
+
+#endif // __RANDOM_GENERATOR_H__
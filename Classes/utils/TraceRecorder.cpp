@@ -0,0 +1,258 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TraceRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 环形缓冲区槽位
+     * sequence为0表示正在写入，否则为写入序号+1；读取前后序号一致才说明读到的内容完整
+     */
+    struct TraceSlot
+    {
+        std::atomic<uint64_t> sequence;
+        std::atomic<const char*> name;
+        std::atomic<uint64_t> beginNs;
+        std::atomic<uint64_t> endNs;
+    };
+    
+    /**
+     * @brief 线程私有缓冲区（只有所属线程写入，创建后不释放，线程退出后仍可导出）
+     */
+    struct ThreadBuffer
+    {
+        int threadIndex;                        // 导出时的tid
+        std::string threadName;                 // 受registryMutex保护
+        std::atomic<uint64_t> writeCount;       // 已写入的区段总数
+        std::atomic<uint64_t> clearedCount;     // clear()时的写入总数，之前的区段不再导出
+        TraceSlot slots[TraceRecorder::BUFFER_CAPACITY];
+    };
+    
+    /**
+     * @brief 导出时读出的一条区段
+     */
+    struct TraceEvent
+    {
+        const char* name;
+        uint64_t beginNs;
+        uint64_t endNs;
+    };
+    
+    std::mutex registryMutex;                   // 保护buffers列表与线程名
+    std::vector<ThreadBuffer*> buffers;
+    thread_local ThreadBuffer* currentBuffer = nullptr;
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    
+    ThreadBuffer* getCurrentBuffer()
+    {
+        if (currentBuffer == nullptr)
+        {
+            ThreadBuffer* buffer = new ThreadBuffer();
+            buffer->writeCount.store(0);
+            buffer->clearedCount.store(0);
+            for (int i = 0; i < TraceRecorder::BUFFER_CAPACITY; ++i)
+            {
+                buffer->slots[i].sequence.store(0);
+                buffer->slots[i].name.store(nullptr);
+                buffer->slots[i].beginNs.store(0);
+                buffer->slots[i].endNs.store(0);
+            }
+            
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffer->threadIndex = (int)buffers.size();
+            buffer->threadName = "thread " + std::to_string(buffer->threadIndex);
+            buffers.push_back(buffer);
+            currentBuffer = buffer;
+        }
+        return currentBuffer;
+    }
+    
+    /**
+     * @brief 读出缓冲区中仍然有效的区段（可与所属线程的写入并发）
+     */
+    void collectEvents(const ThreadBuffer* buffer, std::vector<TraceEvent>& events)
+    {
+        uint64_t count = buffer->writeCount.load(std::memory_order_acquire);
+        uint64_t first = buffer->clearedCount.load(std::memory_order_relaxed);
+        if (count > (uint64_t)TraceRecorder::BUFFER_CAPACITY && first < count - TraceRecorder::BUFFER_CAPACITY)
+        {
+            first = count - TraceRecorder::BUFFER_CAPACITY;
+        }
+        
+        for (uint64_t index = first; index < count; ++index)
+        {
+            const TraceSlot& slot = buffer->slots[index & (TraceRecorder::BUFFER_CAPACITY - 1)];
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != index + 1)
+            {
+                // 已被覆盖或正在写入
+                continue;
+            }
+            TraceEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.beginNs = slot.beginNs.load(std::memory_order_relaxed);
+            event.endNs = slot.endNs.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence || event.name == nullptr)
+            {
+                continue;
+            }
+            events.push_back(event);
+        }
+    }
+    
+    void appendJsonString(std::string& out, const char* text)
+    {
+        out += '"';
+        for (const char* p = text; *p != '\0'; ++p)
+        {
+            char c = *p;
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if ((unsigned char)c < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)c);
+                out += escaped;
+            }
+            else
+            {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+}
+
+std::atomic<bool> TraceRecorder::s_enabled(true);
+
+uint64_t TraceRecorder::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void TraceRecorder::record(const char* name, uint64_t beginNs, uint64_t endNs)
+{
+    if (name == nullptr)
+    {
+        return;
+    }
+    
+    ThreadBuffer* buffer = getCurrentBuffer();
+    uint64_t index = buffer->writeCount.load(std::memory_order_relaxed);
+    TraceSlot& slot = buffer->slots[index & (BUFFER_CAPACITY - 1)];
+    
+    // 先标记为写入中，导出线程看到序号变化会丢弃这条
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.beginNs.store(beginNs, std::memory_order_relaxed);
+    slot.endNs.store(endNs, std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+    buffer->writeCount.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::setThreadName(const std::string& threadName)
+{
+    ThreadBuffer* buffer = getCurrentBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = threadName;
+}
+
+void TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        buffers[i]->clearedCount.store(buffers[i]->writeCount.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+std::string TraceRecorder::exportChromeTrace()
+{
+    std::vector<ThreadBuffer*> snapshot;
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot = buffers;
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            threadNames.push_back(buffers[i]->threadName);
+        }
+    }
+    
+    std::string json = "{\"traceEvents\":[";
+    bool first = true;
+    char line[160];
+    std::vector<TraceEvent> events;
+    for (size_t i = 0; i < snapshot.size(); ++i)
+    {
+        int tid = snapshot[i]->threadIndex;
+        
+        // 线程名元数据
+        json += first ? "\n" : ",\n";
+        first = false;
+        snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", tid);
+        json += line;
+        appendJsonString(json, threadNames[i].c_str());
+        json += "}}";
+        
+        // 完整区段事件，时间单位为微秒
+        events.clear();
+        collectEvents(snapshot[i], events);
+        for (size_t j = 0; j < events.size(); ++j)
+        {
+            const TraceEvent& event = events[j];
+            uint64_t durationNs = event.endNs > event.beginNs ? event.endNs - event.beginNs : 0;
+            json += ",\n{\"name\":";
+            appendJsonString(json, event.name);
+            snprintf(line, sizeof(line), ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                     tid, event.beginNs / 1000.0, durationNs / 1000.0);
+            json += line;
+        }
+    }
+    json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string& filePath)
+{
+    std::string json = exportChromeTrace();
+    FILE* file = fopen(filePath.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+    success = (fclose(file) == 0) && success;
+    return success;
+}
@@ -0,0 +1,131 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __TRACE_RECORDER_H__
+#define __TRACE_RECORDER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 轻量级区段追踪记录器
+ * 每个线程首次记录时创建自己的环形缓冲区，写入只有原子存储、无锁无分配；缓冲区写满后覆盖最旧的记录
+ * 导出可在任意线程进行，读取到正被覆盖的槽位时跳过该条
+ * 导出格式为Chrome Trace Event JSON，可直接拖入chrome://tracing或ui.perfetto.dev查看
+ * 不依赖引擎，定义GAME_DISABLE_TRACE时TRACE_ZONE不产生任何代码
+ */
+class TraceRecorder
+{
+public:
+    static const int BUFFER_CAPACITY = 8192;    // 每个线程保留的区段数（2的幂）
+    
+    /**
+     * @brief 开启/关闭记录（关闭时区段只读取一次开关）
+     */
+    static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 当前时间（纳秒，单调时钟，从进程启动计时）
+     */
+    static uint64_t now();
+    
+    /**
+     * @brief 记录一个已结束的区段（写入当前线程的缓冲区）
+     * @param name 区段名，必须是静态存储期的字符串（通常为字面量）
+     * @param beginNs 开始时间（now()）
+     * @param endNs 结束时间（now()）
+     */
+    static void record(const char* name, uint64_t beginNs, uint64_t endNs);
+    
+    /**
+     * @brief 设置当前线程在导出结果中显示的名称
+     */
+    static void setThreadName(const std::string& threadName);
+    
+    /**
+     * @brief 丢弃所有线程已记录的区段
+     */
+    static void clear();
+    
+    /**
+     * @brief 导出所有线程的区段为Chrome Trace Event JSON
+     */
+    static std::string exportChromeTrace();
+    
+    /**
+     * @brief 导出并写入文件
+     * @return 写入是否成功
+     */
+    static bool writeChromeTrace(const std::string& filePath);
+
+private:
+    TraceRecorder() {}
+    virtual ~TraceRecorder() {}
+    
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief 作用域区段：构造时记录开始时间，析构时写入缓冲区
+ */
+class TraceZone
+{
+public:
+    explicit TraceZone(const char* name)
+    : _name(TraceRecorder::isEnabled() ? name : nullptr)
+    , _beginNs(_name != nullptr ? TraceRecorder::now() : 0)
+    {
+    }
+    
+    ~TraceZone()
+    {
+        if (_name != nullptr)
+        {
+            TraceRecorder::record(_name, _beginNs, TraceRecorder::now());
+        }
+    }
+
+private:
+    TraceZone(const TraceZone&);
+    TraceZone& operator=(const TraceZone&);
+    
+    const char* _name;
+    uint64_t _beginNs;
+};
+
+#define TRACE_ZONE_CONCAT_IMPL(a, b) a##b
+#define TRACE_ZONE_CONCAT(a, b) TRACE_ZONE_CONCAT_IMPL(a, b)
+
+#ifdef GAME_DISABLE_TRACE
+#define TRACE_ZONE(name)
+#else
+/**
+ * @brief 追踪当前作用域，name为字符串字面量
+ */
+#define TRACE_ZONE(name) TraceZone TRACE_ZONE_CONCAT(traceZone, __LINE__)(name)
+#endif
+
+#endif // __TRACE_RECORDER_H__
@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+: _queuedTasks(0)
+, _pendingTasks(0)
+, _nextQueue(0)
+, _stopping(false)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount <= 0)
+        {
+            threadCount = 1;
+        }
+    }
+    
+    for (int i = 0; i < threadCount; ++i)
+    {
+        _queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < threadCount; ++i)
+    {
+        _threads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    waitAll();
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+    for (std::thread& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(const Task& task)
+{
+    if (task == nullptr)
+    {
+        return;
+    }
+    
+    WorkerQueue* queue = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        queue = _queues[_nextQueue++ % _queues.size()].get();
+        ++_pendingTasks;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back(task);
+    }
+    {
+        // 在状态锁内增加计数，避免工作线程检查条件后错过唤醒
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        ++_queuedTasks;
+    }
+    _workAvailable.notify_one();
+}
+
+void WorkStealingPool::waitAll()
+{
+    std::unique_lock<std::mutex> lock(_stateMutex);
+    _allDone.wait(lock, [this]() { return _pendingTasks == 0; });
+}
+
+bool WorkStealingPool::takeTask(int workerIndex, Task& task)
+{
+    // 自己的队列：后进先出，缓存更友好
+    {
+        WorkerQueue* queue = _queues[workerIndex].get();
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->tasks.empty())
+        {
+            task = std::move(queue->tasks.back());
+            queue->tasks.pop_back();
+            --_queuedTasks;
+            return true;
+        }
+    }
+    
+    // 窃取其他队列：先进先出，取走最早提交的任务
+    int queueCount = (int)_queues.size();
+    for (int offset = 1; offset < queueCount; ++offset)
+    {
+        WorkerQueue* queue = _queues[(workerIndex + offset) % queueCount].get();
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->tasks.empty())
+        {
+            task = std::move(queue->tasks.front());
+            queue->tasks.pop_front();
+            --_queuedTasks;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int workerIndex)
+{
+    while (true)
+    {
+        Task task;
+        if (takeTask(workerIndex, task))
+        {
+            task(workerIndex);
+            
+            std::lock_guard<std::mutex> lock(_stateMutex);
+            if (--_pendingTasks == 0)
+            {
+                _allDone.notify_all();
+            }
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(_stateMutex);
+        _workAvailable.wait(lock, [this]() { return _stopping || _queuedTasks > 0; });
+        if (_stopping && _queuedTasks == 0)
+        {
+            return;
+        }
+    }
+}
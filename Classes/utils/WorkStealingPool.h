@@ -0,0 +1,106 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __WORK_STEALING_POOL_H__
+#define __WORK_STEALING_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 工作窃取线程池
+ * 每个工作线程拥有独立的任务队列：从自己队列尾部取任务，空闲时从其他队列头部窃取
+ * 适用于耗时不均匀的批量任务（如牌局模拟、求解）
+ */
+class WorkStealingPool
+{
+public:
+    /**
+     * @brief 任务类型
+     * @param workerIndex 执行任务的工作线程下标（0 ~ getThreadCount()-1），可用于访问线程私有数据
+     */
+    typedef std::function<void(int workerIndex)> Task;
+    
+    /**
+     * @brief 构造线程池
+     * @param threadCount 工作线程数，小于等于0时使用硬件并发数
+     */
+    explicit WorkStealingPool(int threadCount = 0);
+    virtual ~WorkStealingPool();
+    
+    /**
+     * @brief 获取工作线程数
+     */
+    int getThreadCount() const { return (int)_threads.size(); }
+    
+    /**
+     * @brief 提交任务（轮流分配到各工作线程队列）
+     * @param task 任务
+     */
+    void submit(const Task& task);
+    
+    /**
+     * @brief 阻塞等待所有已提交的任务执行完毕
+     */
+    void waitAll();
+
+private:
+    /**
+     * @brief 工作线程私有队列
+     */
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    
+    /**
+     * @brief 取出任务：优先自己队列尾部，其次窃取其他队列头部
+     */
+    bool takeTask(int workerIndex, Task& task);
+    
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop(int workerIndex);
+    
+    std::vector<std::thread> _threads;                      // 工作线程
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;      // 每个线程的任务队列
+    std::mutex _stateMutex;                                 // 保护等待/唤醒状态
+    std::condition_variable _workAvailable;                 // 有新任务
+    std::condition_variable _allDone;                       // 所有任务完成
+    std::atomic<int> _queuedTasks;                          // 队列中尚未取出的任务数
+    int _pendingTasks;                                      // 尚未执行完的任务数（受_stateMutex保护）
+    unsigned int _nextQueue;                                // 下一个分配的队列
+    bool _stopping;                                         // 是否正在销毁
+};
+
+#endif // __WORK_STEALING_POOL_H__
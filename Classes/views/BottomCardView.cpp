@@ -25,6 +25,8 @@
 #include "BottomCardView.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
+#include "../utils/TraceRecorder.h"
+#include "CardViewPool.h"
 
 USING_NS_CC;
 
@@ -49,6 +51,8 @@ bool BottomCardView::init(const GameModel* gameModel)
     
     _gameModel = gameModel;
     _cardView = nullptr;
+    _cardViewPool = nullptr;
+    _cardEpoch = 0;
     _cardSize = Size(100, 140);
     
     // 底牌视图区域：540*580，底牌居中显示
@@ -61,28 +65,37 @@ bool BottomCardView::init(const GameModel* gameModel)
 
 void BottomCardView::updateView(const GameModel* gameModel)
 {
+    TRACE_ZONE("BottomCardView::updateView");
+    
     if (gameModel == nullptr)
     {
         return;
     }
     
+    // 底牌未变化（同一牌局、同一张牌）时保留现有卡牌视图
+    int bottomCardId = gameModel->getBottomCardId();
+    if (_cardView != nullptr && gameModel == _gameModel && _cardView->getCardId() == bottomCardId
+        && _cardEpoch == gameModel->getZoneChangeEpoch())
+    {
+        return;
+    }
     _gameModel = gameModel;
+    _cardEpoch = gameModel->getZoneChangeEpoch();
     
     // 移除现有卡牌视图
     if (_cardView != nullptr)
     {
-        _cardView->removeFromParent();
+        releaseCardView(_cardView);
         _cardView = nullptr;
     }
     
     // 创建新的卡牌视图
-    int bottomCardId = gameModel->getBottomCardId();
     if (bottomCardId > 0)
     {
         const CardModel* cardModel = gameModel->getCardById(bottomCardId);
         if (cardModel != nullptr)
         {
-            _cardView = CardView::create(cardModel);
+            _cardView = acquireCardView(cardModel);
             if (_cardView != nullptr)
             {
                 // 底牌在区域中居中显示，与备选牌堆保持水平对齐
@@ -103,7 +116,7 @@ void BottomCardView::playReplaceAnimation(int cardId, float duration, const std:
         const CardModel* cardModel = _gameModel->getCardById(cardId);
         if (cardModel != nullptr)
         {
-            CardView* newCardView = CardView::create(cardModel);
+            CardView* newCardView = acquireCardView(cardModel);
             if (newCardView != nullptr)
             {
                 newCardView->setPosition(Vec2(_cardSize.width / 2, _cardSize.height / 2));
@@ -117,7 +130,7 @@ void BottomCardView::playReplaceAnimation(int cardId, float duration, const std:
                     auto callFunc = CallFunc::create([this, newCardView, callback]() {
                         if (_cardView != nullptr)
                         {
-                            _cardView->removeFromParent();
+                            releaseCardView(_cardView);
                         }
                         _cardView = newCardView;
                         callback();
@@ -129,7 +142,7 @@ void BottomCardView::playReplaceAnimation(int cardId, float duration, const std:
                     auto callFunc = CallFunc::create([this, newCardView]() {
                         if (_cardView != nullptr)
                         {
-                            _cardView->removeFromParent();
+                            releaseCardView(_cardView);
                         }
                         _cardView = newCardView;
                     });
@@ -151,3 +164,23 @@ void BottomCardView::playUndoAnimation(int cardId, float duration, const std::fu
     }
 }
 
+CardView* BottomCardView::acquireCardView(const CardModel* cardModel)
+{
+    if (_cardViewPool != nullptr)
+    {
+        return _cardViewPool->acquire(cardModel);
+    }
+    return CardView::create(cardModel);
+}
+
+void BottomCardView::releaseCardView(CardView* cardView)
+{
+    if (_cardViewPool != nullptr)
+    {
+        _cardViewPool->recycle(cardView);
+    }
+    else
+    {
+        cardView->removeFromParent();
+    }
+}
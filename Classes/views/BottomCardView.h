@@ -30,6 +30,7 @@
 
 // 前向声明
 class GameModel;
+class CardViewPool;
 
 /**
  * @brief 底牌视图
@@ -78,10 +79,23 @@ public:
      * @brief 获取卡牌视图
      */
     CardView* getCardView() const { return _cardView; }
+    
+    /**
+     * @brief 设置卡牌视图对象池（不持有），设置后卡牌视图从池中取出、移除时回收到池中
+     */
+    void setCardViewPool(CardViewPool* cardViewPool) { _cardViewPool = cardViewPool; }
 
 private:
+    /**
+     * @brief 从对象池取出（未设置对象池时创建）/ 回收（未设置对象池时直接移除）卡牌视图
+     */
+    CardView* acquireCardView(const CardModel* cardModel);
+    void releaseCardView(CardView* cardView);
+    
     const GameModel* _gameModel;                     // 游戏模型（const指针）
     CardView* _cardView;                              // 底牌视图
+    CardViewPool* _cardViewPool;                      // 卡牌视图对象池（不持有，可为空）
+    unsigned int _cardEpoch;                          // 底牌视图对应的区域变化代数（牌局整体替换后重建）
     cocos2d::Size _cardSize;                          // 卡牌尺寸
 };
 
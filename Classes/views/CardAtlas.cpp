@@ -0,0 +1,184 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "CardAtlas.h"
+#include "CardView.h"
+#include "../models/CardModel.h"
+#include "2d/CCRenderTexture.h"
+#include "2d/CCSprite.h"
+#include "base/CCDirector.h"
+#include "renderer/CCRenderer.h"
+
+USING_NS_CC;
+
+namespace
+{
+    const int FACE_CELL_COUNT = CST_NUM_CARD_SUIT_TYPES * CFT_NUM_CARD_FACE_TYPES;     // 52张牌面
+    const int BACK_CELL_INDEX = FACE_CELL_COUNT;                                        // 牌背在最后一格
+}
+
+CardAtlas* CardAtlas::_instance = nullptr;
+
+CardAtlas* CardAtlas::getInstance()
+{
+    if (_instance == nullptr)
+    {
+        _instance = new CardAtlas();
+    }
+    return _instance;
+}
+
+void CardAtlas::destroyInstance()
+{
+    if (_instance != nullptr)
+    {
+        delete _instance;
+        _instance = nullptr;
+    }
+}
+
+CardAtlas::CardAtlas()
+: _renderTexture(nullptr)
+, _cardSize(Size::ZERO)
+, _ready(false)
+{
+}
+
+CardAtlas::~CardAtlas()
+{
+    CC_SAFE_RELEASE_NULL(_renderTexture);
+}
+
+bool CardAtlas::build()
+{
+    if (_ready)
+    {
+        return true;
+    }
+    
+    // 格子尺寸取卡牌背景图尺寸，与CardView一致
+    Texture2D* bgTexture = CardResConfig::getInstance()->getCardBackgroundTexture();
+    if (bgTexture == nullptr)
+    {
+        return false;
+    }
+    Size cardSize = bgTexture->getContentSize();
+    
+    int rows = (BACK_CELL_INDEX + COLUMNS) / COLUMNS;
+    RenderTexture* renderTexture = RenderTexture::create((int)(cardSize.width * COLUMNS), (int)(cardSize.height * rows),
+                                                         Texture2D::PixelFormat::RGBA8888);
+    if (renderTexture == nullptr)
+    {
+        return false;
+    }
+    renderTexture->retain();
+    CC_SAFE_RELEASE_NULL(_renderTexture);
+    _renderTexture = renderTexture;
+    _cardSize = cardSize;
+    
+    // 牌面直接用未合图的CardView绘制（此时isReady()仍为false），排版与逐精灵显示完全一致
+    // 临时节点都是autorelease对象，在本帧结束前有效，下面的render会先执行合成
+    renderTexture->beginWithClear(0.0f, 0.0f, 0.0f, 0.0f);
+    for (int suit = 0; suit < CST_NUM_CARD_SUIT_TYPES; ++suit)
+    {
+        for (int face = 0; face < CFT_NUM_CARD_FACE_TYPES; ++face)
+        {
+            CardModel cardModel(0, (CardSuitType)suit, (CardFaceType)face);
+            CardView* cardView = CardView::create(&cardModel);
+            if (cardView == nullptr)
+            {
+                continue;
+            }
+            Rect cellRect = getCellRect(suit * CFT_NUM_CARD_FACE_TYPES + face);
+            cardView->setPosition(Vec2(cellRect.getMidX(), cellRect.getMidY()));
+            cardView->visit();
+        }
+    }
+    Rect backRect = getCellRect(BACK_CELL_INDEX);
+    drawCardBack(Vec2(backRect.getMidX(), backRect.getMidY()));
+    renderTexture->end();
+    
+    // 立即执行合成命令，之后同一帧内的卡牌即可引用图集
+    Director::getInstance()->getRenderer()->render();
+    _ready = true;
+    return true;
+}
+
+void CardAtlas::drawCardBack(const Vec2& center)
+{
+    CardResConfig* resConfig = CardResConfig::getInstance();
+    Texture2D* backgroundTexture = resConfig->getCardBackgroundTexture();
+    Sprite* background = backgroundTexture != nullptr ? Sprite::createWithTexture(backgroundTexture) : nullptr;
+    if (background != nullptr)
+    {
+        background->setPosition(center);
+        background->visit();
+    }
+    
+    // 牌背图片是可选资源，不存在时只绘制背景
+    Texture2D* backTexture = resConfig->getCardBackTexture();
+    if (backTexture != nullptr)
+    {
+        Sprite* back = Sprite::createWithTexture(backTexture);
+        if (back != nullptr)
+        {
+            back->setPosition(center);
+            back->setScale(std::min(_cardSize.width / back->getContentSize().width,
+                                    _cardSize.height / back->getContentSize().height));
+            back->visit();
+        }
+    }
+}
+
+Texture2D* CardAtlas::getTexture() const
+{
+    if (!_ready)
+    {
+        return nullptr;
+    }
+    return _renderTexture->getSprite()->getTexture();
+}
+
+Rect CardAtlas::getFaceRect(CardSuitType suit, CardFaceType face) const
+{
+    if (suit < 0 || suit >= CST_NUM_CARD_SUIT_TYPES || face < 0 || face >= CFT_NUM_CARD_FACE_TYPES)
+    {
+        return getBackRect();
+    }
+    return getCellRect(suit * CFT_NUM_CARD_FACE_TYPES + face);
+}
+
+Rect CardAtlas::getBackRect() const
+{
+    return getCellRect(BACK_CELL_INDEX);
+}
+
+Rect CardAtlas::getCellRect(int index) const
+{
+    // RenderTexture的纹理原点在左下角，这里的区域同时用作绘制位置和纹理区域（精灵上下翻转后显示为正向）
+    int column = index % COLUMNS;
+    int row = index / COLUMNS;
+    return Rect(column * _cardSize.width, row * _cardSize.height, _cardSize.width, _cardSize.height);
+}
@@ -0,0 +1,108 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CARD_ATLAS_H__
+#define __CARD_ATLAS_H__
+
+#include "cocos2d.h"
+#include "../configs/models/CardResConfig.h"
+
+/**
+ * @brief 卡牌图集
+ * 启动时用RenderTexture把52张牌面和牌背各合成一次，存放在同一张纹理中
+ * 卡牌视图只需一个引用图集的精灵（一个四边形），整个牌面使用同一纹理和混合方式，可以合批绘制
+ * 布局：每格一张卡牌（尺寸同卡牌背景图），按 花色 * 13 + 点数 逐行排列，最后一格为牌背
+ */
+class CardAtlas
+{
+public:
+    /**
+     * @brief 获取单例实例
+     */
+    static CardAtlas* getInstance();
+    
+    /**
+     * @brief 销毁单例实例（释放图集纹理）
+     */
+    static void destroyInstance();
+    
+    /**
+     * @brief 合成图集（已合成时直接返回true）
+     * 需要在GL上下文创建之后、创建卡牌视图之前调用（由LoadingController在纹理预加载完成后调用），内部立即执行一次渲染
+     * @return 是否成功，失败时卡牌视图仍按原方式逐个精灵显示
+     */
+    bool build();
+    
+    /**
+     * @brief 图集是否可用
+     */
+    bool isReady() const { return _ready; }
+    
+    /**
+     * @brief 获取图集纹理（未合成时返回nullptr）
+     */
+    cocos2d::Texture2D* getTexture() const;
+    
+    /**
+     * @brief 获取牌面在图集中的区域（纹理坐标，内容上下颠倒，精灵需设置setFlippedY(true)）
+     * @param suit 花色
+     * @param face 点数
+     */
+    cocos2d::Rect getFaceRect(CardSuitType suit, CardFaceType face) const;
+    
+    /**
+     * @brief 获取牌背在图集中的区域
+     */
+    cocos2d::Rect getBackRect() const;
+    
+    /**
+     * @brief 获取单张卡牌尺寸
+     */
+    const cocos2d::Size& getCardSize() const { return _cardSize; }
+
+private:
+    CardAtlas();
+    virtual ~CardAtlas();
+    
+    /**
+     * @brief 第index格在图集中的区域
+     */
+    cocos2d::Rect getCellRect(int index) const;
+    
+    /**
+     * @brief 在当前RenderTexture中绘制牌背
+     */
+    void drawCardBack(const cocos2d::Vec2& center);
+    
+    static CardAtlas* _instance;
+    
+    static const int COLUMNS = 8;       // 每行格数（8列 * 7行，182*282的卡牌不超过2048*2048）
+    
+    cocos2d::RenderTexture* _renderTexture;     // 图集（持有引用）
+    cocos2d::Size _cardSize;                    // 单张卡牌尺寸
+    bool _ready;                                // 是否已合成完成
+};
+
+#endif // __CARD_ATLAS_H__
@@ -0,0 +1,201 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CardMotionSystem.h"
+#include "CardView.h"
+#include "../services/RenderOnDemandService.h"
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
+#include <algorithm>
+#include <cfloat>
+
+USING_NS_CC;
+
+CardMotionSystem* CardMotionSystem::_instance = nullptr;
+
+CardMotionSystem* CardMotionSystem::getInstance()
+{
+    if (_instance == nullptr)
+    {
+        _instance = new CardMotionSystem();
+    }
+    return _instance;
+}
+
+void CardMotionSystem::destroyInstance()
+{
+    if (_instance != nullptr)
+    {
+        delete _instance;
+        _instance = nullptr;
+    }
+}
+
+CardMotionSystem::CardMotionSystem()
+: _scheduled(false)
+{
+}
+
+CardMotionSystem::~CardMotionSystem()
+{
+    if (_scheduled)
+    {
+        Director::getInstance()->getScheduler()->unscheduleUpdate(this);
+        RenderOnDemandService::releaseWakeLock();
+    }
+    for (CardView* cardView : _cardViews)
+    {
+        cardView->release();
+    }
+}
+
+void CardMotionSystem::moveTo(CardView* cardView, const Vec2& targetPos, float duration,
+                              const std::function<void()>& callback)
+{
+    if (cardView == nullptr)
+    {
+        return;
+    }
+    
+    Vec2 startPos = cardView->getPosition();
+    cardView->retain();
+    _cardViews.push_back(cardView);
+    _startX.push_back(startPos.x);
+    _startY.push_back(startPos.y);
+    _deltaX.push_back(targetPos.x - startPos.x);
+    _deltaY.push_back(targetPos.y - startPos.y);
+    _elapsed.push_back(0.0f);
+    // 时长为0时下一帧进度直接为1
+    _invDuration.push_back(duration > FLT_EPSILON ? 1.0f / duration : FLT_MAX);
+    _callbacks.push_back(callback);
+    
+    if (!_scheduled)
+    {
+        Director::getInstance()->getScheduler()->scheduleUpdate(this, 0, false);
+        RenderOnDemandService::acquireWakeLock();
+        _scheduled = true;
+    }
+}
+
+void CardMotionSystem::stop(CardView* cardView)
+{
+    for (size_t i = _cardViews.size(); i > 0; --i)
+    {
+        if (_cardViews[i - 1] == cardView)
+        {
+            removeAt(i - 1, nullptr);
+        }
+    }
+}
+
+bool CardMotionSystem::isMoving(const CardView* cardView) const
+{
+    return std::find(_cardViews.begin(), _cardViews.end(), cardView) != _cardViews.end();
+}
+
+void CardMotionSystem::removeAt(size_t index, std::function<void()>* callback)
+{
+    size_t last = _cardViews.size() - 1;
+    CardView* cardView = _cardViews[index];
+    if (callback != nullptr)
+    {
+        callback->swap(_callbacks[index]);
+    }
+    
+    _cardViews[index] = _cardViews[last];
+    _startX[index] = _startX[last];
+    _startY[index] = _startY[last];
+    _deltaX[index] = _deltaX[last];
+    _deltaY[index] = _deltaY[last];
+    _elapsed[index] = _elapsed[last];
+    _invDuration[index] = _invDuration[last];
+    _callbacks[index].swap(_callbacks[last]);
+    
+    _cardViews.pop_back();
+    _startX.pop_back();
+    _startY.pop_back();
+    _deltaX.pop_back();
+    _deltaY.pop_back();
+    _elapsed.pop_back();
+    _invDuration.pop_back();
+    _callbacks.pop_back();
+    
+    cardView->release();
+}
+
+void CardMotionSystem::update(float dt)
+{
+    size_t count = _cardViews.size();
+    
+    // 先在连续数组上计算进度（无分支，编译器可向量化），再逐个写回位置
+    _progress.resize(count);
+    float* elapsed = _elapsed.data();
+    const float* invDuration = _invDuration.data();
+    float* progress = _progress.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        elapsed[i] += dt;
+        progress[i] = std::min(elapsed[i] * invDuration[i], 1.0f);
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        _cardViews[i]->setPosition(_startX[i] + _deltaX[i] * progress[i], _startY[i] + _deltaY[i] * progress[i]);
+    }
+    
+    // 移出已完成的动画（从后往前，与末尾交换不影响未检查的下标）
+    _finishedCallbacks.clear();
+    for (size_t i = count; i > 0; --i)
+    {
+        if (progress[i - 1] >= 1.0f)
+        {
+            _finishedCallbacks.push_back(nullptr);
+            removeAt(i - 1, &_finishedCallbacks.back());
+        }
+    }
+    
+    // 集中调用完成回调（回调中可以开始新的动画，从下一帧开始推进），先交换出来保证重入安全
+    std::vector<std::function<void()> > callbacks;
+    callbacks.swap(_finishedCallbacks);
+    for (size_t i = 0; i < callbacks.size(); ++i)
+    {
+        if (callbacks[i] != nullptr)
+        {
+            callbacks[i]();
+        }
+    }
+    callbacks.clear();
+    if (_finishedCallbacks.empty())
+    {
+        // 归还容量供下一帧复用
+        _finishedCallbacks.swap(callbacks);
+    }
+    
+    // 回调之后仍没有动画才注销（同一帧内注销后再注册会被调度器忽略）
+    if (_cardViews.empty() && _scheduled)
+    {
+        Director::getInstance()->getScheduler()->unscheduleUpdate(this);
+        RenderOnDemandService::releaseWakeLock();
+        _scheduled = false;
+    }
+}
@@ -0,0 +1,108 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CARD_MOTION_SYSTEM_H__
+#define __CARD_MOTION_SYSTEM_H__
+
+#include "cocos2d.h"
+#include <functional>
+#include <vector>
+
+// 前向声明
+class CardView;
+
+/**
+ * @brief 卡牌平移动画系统
+ * 所有进行中的卡牌平移保存在一组连续数组中（按字段分开存放），每帧一次调度回调统一推进插值并写回位置，
+ * 结束的动画先全部移出数组，再集中调用完成回调；数组容量保留复用，稳定后开始动画不再分配内存
+ * 只有存在动画时才注册调度回调；动画期间持有卡牌视图的引用
+ */
+class CardMotionSystem
+{
+public:
+    /**
+     * @brief 获取单例实例
+     */
+    static CardMotionSystem* getInstance();
+    
+    /**
+     * @brief 销毁单例实例（丢弃进行中的动画，不调用完成回调）
+     */
+    static void destroyInstance();
+    
+    /**
+     * @brief 开始平移动画（从当前位置匀速移动到目标位置，与MoveTo一致）
+     * @param cardView 卡牌视图
+     * @param targetPos 目标位置（父节点坐标）
+     * @param duration 动画时长（秒），不大于0时在下一帧直接到达
+     * @param callback 到达后的回调，可为nullptr
+     */
+    void moveTo(CardView* cardView, const cocos2d::Vec2& targetPos, float duration,
+                const std::function<void()>& callback = nullptr);
+    
+    /**
+     * @brief 停止该卡牌的所有平移动画（停在当前位置，不调用完成回调，与stopAllActions一致）
+     */
+    void stop(CardView* cardView);
+    
+    /**
+     * @brief 该卡牌是否正在平移
+     */
+    bool isMoving(const CardView* cardView) const;
+    
+    /**
+     * @brief 进行中的动画数量
+     */
+    size_t getActiveCount() const { return _cardViews.size(); }
+    
+    /**
+     * @brief 调度回调：推进所有动画
+     */
+    void update(float dt);
+
+private:
+    CardMotionSystem();
+    ~CardMotionSystem();
+    
+    /**
+     * @brief 移除第index个动画（与末尾交换），返回其完成回调
+     */
+    void removeAt(size_t index, std::function<void()>* callback);
+    
+    static CardMotionSystem* _instance;
+    
+    std::vector<CardView*> _cardViews;                  // 动画目标（持有引用）
+    std::vector<float> _startX;                         // 起点
+    std::vector<float> _startY;
+    std::vector<float> _deltaX;                         // 终点 - 起点
+    std::vector<float> _deltaY;
+    std::vector<float> _elapsed;                        // 已播放时长
+    std::vector<float> _invDuration;                    // 1 / 时长
+    std::vector<std::function<void()> > _callbacks;     // 完成回调
+    std::vector<float> _progress;                       // 本帧进度（0~1），每帧复用
+    std::vector<std::function<void()> > _finishedCallbacks;  // 本帧完成的回调，每帧复用
+    bool _scheduled;                                    // 是否已注册调度回调（注册期间持有按需渲染唤醒锁）
+};
+
+#endif // __CARD_MOTION_SYSTEM_H__
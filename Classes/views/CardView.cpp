@@ -25,13 +25,25 @@
 #include "CardView.h"
 #include "../models/CardModel.h"
 #include "../configs/models/CardResConfig.h"
+#include "CardAtlas.h"
+#include "CardMotionSystem.h"
 #include "2d/CCDrawNode.h"
 #include "2d/CCSprite.h"
-#include "renderer/CCTextureCache.h"
 #include "base/CCEventListenerTouch.h"
 #include "base/CCEventDispatcher.h"
 #include "base/CCDirector.h"
 
+namespace
+{
+    /**
+     * @brief 用已解析的纹理句柄创建精灵（纹理为nullptr时返回nullptr）
+     */
+    cocos2d::Sprite* createSprite(cocos2d::Texture2D* texture)
+    {
+        return texture != nullptr ? cocos2d::Sprite::createWithTexture(texture) : nullptr;
+    }
+}
+
 CardView* CardView::create(const CardModel* cardModel)
 {
     CardView* view = new CardView();
@@ -59,23 +71,32 @@ bool CardView::init(const CardModel* cardModel)
     _cardModel = cardModel;
     _cardId = cardModel->getCardId();
     
-    // 从card_general.png获取实际卡牌尺寸
-    std::string bgPath = CardResConfig::getInstance()->getCardBackgroundPath();
-    auto texture = cocos2d::Director::getInstance()->getTextureCache()->addImage(bgPath);
-    if (texture != nullptr)
+    // 从card_general.png获取实际卡牌尺寸（图集的格子尺寸与之相同，可直接使用）
+    CardAtlas* atlas = CardAtlas::getInstance();
+    if (atlas->isReady())
     {
-        cocos2d::Size textureSize = texture->getContentSize();
-        _cardSize = textureSize;
+        _cardSize = atlas->getCardSize();
     }
     else
     {
-        // 如果加载失败，使用默认尺寸
-        _cardSize = cocos2d::Size(100, 140);
+        cocos2d::Texture2D* texture = CardResConfig::getInstance()->getCardBackgroundTexture();
+        if (texture != nullptr)
+        {
+            cocos2d::Size textureSize = texture->getContentSize();
+            _cardSize = textureSize;
+        }
+        else
+        {
+            // 如果加载失败，使用默认尺寸
+            _cardSize = cocos2d::Size(100, 140);
+        }
     }
     _backgroundSprite = nullptr;
     _smallNumberSprite = nullptr;
     _suitSprite = nullptr;
     _bigNumberSprite = nullptr;
+    _faceSprite = nullptr;
+    _culled = false;
     
     // 设置内容尺寸
     this->setContentSize(_cardSize);
@@ -102,29 +123,88 @@ void CardView::updateCard(const CardModel* cardModel)
     updateCardElements();
 }
 
-void CardView::playMoveAnimation(const cocos2d::Vec2& targetPos, float duration, 
-                                const std::function<void()>& callback)
+void CardView::rebind(const CardModel* cardModel)
 {
-    auto moveAction = cocos2d::MoveTo::create(duration, targetPos);
+    if (cardModel == nullptr)
+    {
+        return;
+    }
+    
+    _cardModel = cardModel;
+    _cardId = cardModel->getCardId();
     
-    if (callback != nullptr)
+    // 清除上次使用留下的动画状态（提示闪烁、淡入、平移等）
+    this->stopAllActions();
+    CardMotionSystem::getInstance()->stop(this);
+    this->setScale(1.0f);
+    this->setRotation(0.0f);
+    this->setOpacity(255);
+    this->setVisible(true);
+    setCulled(false);
+    
+    updateCardElements();
+}
+
+void CardView::setCulled(bool culled)
+{
+    if (_culled == culled)
     {
-        auto callFunc = cocos2d::CallFunc::create(callback);
-        this->runAction(cocos2d::Sequence::create(moveAction, callFunc, nullptr));
+        return;
     }
-    else
+    _culled = culled;
+    if (!culled)
+    {
+        // 裁剪期间父节点可能移动过，与setVisible(true)一样强制重新计算变换
+        _transformUpdated = _transformDirty = _inverseDirty = true;
+    }
+}
+
+void CardView::visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_culled)
     {
-        this->runAction(moveAction);
+        return;
     }
+    Node::visit(renderer, parentTransform, parentFlags);
+}
+
+void CardView::playMoveAnimation(const cocos2d::Vec2& targetPos, float duration, 
+                                const std::function<void()>& callback)
+{
+    // 平移由CardMotionSystem统一推进，不为每次动画创建动作对象
+    CardMotionSystem::getInstance()->moveTo(this, targetPos, duration, callback);
+}
+
+void CardView::cleanup()
+{
+    // 与动作一样，移出场景并清理时停止平移且不再回调
+    CardMotionSystem::getInstance()->stop(this);
+    Node::cleanup();
 }
 
 void CardView::createCardElements()
 {
+    // 图集可用时整张牌面只用一个精灵
+    CardAtlas* atlas = CardAtlas::getInstance();
+    if (atlas->isReady())
+    {
+        _faceSprite = cocos2d::Sprite::createWithTexture(atlas->getTexture(),
+                                                         atlas->getFaceRect(_cardModel->getSuit(), _cardModel->getFace()));
+        if (_faceSprite != nullptr)
+        {
+            // RenderTexture内容上下颠倒，且合成时颜色已乘过透明度
+            _faceSprite->setFlippedY(true);
+            _faceSprite->setBlendFunc(cocos2d::BlendFunc::ALPHA_PREMULTIPLIED);
+            _faceSprite->setPosition(cocos2d::Vec2(_cardSize.width / 2, _cardSize.height / 2));
+            this->addChild(_faceSprite, 0);
+            return;
+        }
+    }
+    
     CardResConfig* resConfig = CardResConfig::getInstance();
     
     // 创建背景（白色，圆角）
-    std::string bgPath = resConfig->getCardBackgroundPath();
-    _backgroundSprite = cocos2d::Sprite::create(bgPath);
+    _backgroundSprite = createSprite(resConfig->getCardBackgroundTexture());
     if (_backgroundSprite != nullptr)
     {
         _backgroundSprite->setPosition(cocos2d::Vec2(_cardSize.width / 2, _cardSize.height / 2));
@@ -147,8 +227,7 @@ void CardView::createCardElements()
     bool isRed = resConfig->isRedSuit(_cardModel->getSuit());
     
     // 创建左上角小数字（位置：左上角，小尺寸）
-    std::string smallNumPath = resConfig->getSmallNumberImagePath(_cardModel->getFace(), isRed);
-    _smallNumberSprite = cocos2d::Sprite::create(smallNumPath);
+    _smallNumberSprite = createSprite(resConfig->getSmallNumberTexture(_cardModel->getFace(), isRed));
     if (_smallNumberSprite != nullptr)
     {
         // 左上角位置，距离边缘约8-10%
@@ -162,8 +241,7 @@ void CardView::createCardElements()
     }
     
     // 创建左上角花色（紧邻小数字右侧）
-    std::string suitPath = resConfig->getSuitImagePath(_cardModel->getSuit());
-    _suitSprite = cocos2d::Sprite::create(suitPath);
+    _suitSprite = createSprite(resConfig->getSuitTexture(_cardModel->getSuit()));
     if (_suitSprite != nullptr)
     {
         // 花色在小数字右侧，稍微偏上
@@ -177,8 +255,7 @@ void CardView::createCardElements()
     }
     
     // 创建中央大数字（居中，大尺寸，有光泽效果）
-    std::string bigNumPath = resConfig->getBigNumberImagePath(_cardModel->getFace(), isRed);
-    _bigNumberSprite = cocos2d::Sprite::create(bigNumPath);
+    _bigNumberSprite = createSprite(resConfig->getBigNumberTexture(_cardModel->getFace(), isRed));
     if (_bigNumberSprite != nullptr)
     {
         // 居中位置，稍微偏下一点（视觉中心）
@@ -194,14 +271,20 @@ void CardView::createCardElements()
 
 void CardView::updateCardElements()
 {
+    // 使用图集时只需切换纹理区域
+    if (_faceSprite != nullptr)
+    {
+        _faceSprite->setTextureRect(CardAtlas::getInstance()->getFaceRect(_cardModel->getSuit(), _cardModel->getFace()));
+        return;
+    }
+    
     CardResConfig* resConfig = CardResConfig::getInstance();
     bool isRed = resConfig->isRedSuit(_cardModel->getSuit());
     
     // 更新左上角小数字
     if (_smallNumberSprite != nullptr)
     {
-        std::string smallNumPath = resConfig->getSmallNumberImagePath(_cardModel->getFace(), isRed);
-        auto texture = cocos2d::Director::getInstance()->getTextureCache()->addImage(smallNumPath);
+        cocos2d::Texture2D* texture = resConfig->getSmallNumberTexture(_cardModel->getFace(), isRed);
         if (texture != nullptr)
         {
             _smallNumberSprite->setTexture(texture);
@@ -214,8 +297,7 @@ void CardView::updateCardElements()
     // 更新左上角花色
     if (_suitSprite != nullptr)
     {
-        std::string suitPath = resConfig->getSuitImagePath(_cardModel->getSuit());
-        auto texture = cocos2d::Director::getInstance()->getTextureCache()->addImage(suitPath);
+        cocos2d::Texture2D* texture = resConfig->getSuitTexture(_cardModel->getSuit());
         if (texture != nullptr)
         {
             _suitSprite->setTexture(texture);
@@ -228,8 +310,7 @@ void CardView::updateCardElements()
     // 更新中央大数字
     if (_bigNumberSprite != nullptr)
     {
-        std::string bigNumPath = resConfig->getBigNumberImagePath(_cardModel->getFace(), isRed);
-        auto texture = cocos2d::Director::getInstance()->getTextureCache()->addImage(bigNumPath);
+        cocos2d::Texture2D* texture = resConfig->getBigNumberTexture(_cardModel->getFace(), isRed);
         if (texture != nullptr)
         {
             _bigNumberSprite->setTexture(texture);
@@ -34,6 +34,7 @@ class CardModel;
  * @brief 卡牌视图
  * 负责卡牌的UI显示，可持有const类型的model指针
  * 卡片由背景、左上角小数字、右上角花色、中央大数字组成
+ * 卡牌图集（CardAtlas）可用时只创建一个引用图集的精灵，所有卡牌共用同一纹理，可合批绘制
  */
 class CardView : public cocos2d::Node
 {
@@ -64,7 +65,13 @@ public:
     void updateCard(const CardModel* cardModel);
     
     /**
-     * @brief 播放平移动画
+     * @brief 绑定到另一张卡牌并恢复初始显示状态（对象池复用时调用，不重新创建子精灵）
+     * @param cardModel 卡牌数据模型
+     */
+    void rebind(const CardModel* cardModel);
+    
+    /**
+     * @brief 播放平移动画（由CardMotionSystem推进，移出场景或rebind时停止）
      * @param targetPos 目标位置
      * @param duration 动画时长
      * @param callback 完成回调
@@ -76,6 +83,23 @@ public:
      * @brief 获取卡牌尺寸
      */
     cocos2d::Size getCardSize() const { return _cardSize; }
+    
+    /**
+     * @brief 设置是否被父视图裁剪（屏幕外或被完全挡住），裁剪时visit跳过整张卡牌，不改变visible
+     */
+    void setCulled(bool culled);
+    bool isCulled() const { return _culled; }
+    
+    using cocos2d::Node::visit;
+    /**
+     * @brief 被裁剪时不遍历子节点
+     */
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
+    
+    /**
+     * @brief 移出场景清理时停止平移动画
+     */
+    virtual void cleanup() override;
 
 private:
     /**
@@ -95,7 +119,9 @@ private:
     cocos2d::Sprite* _smallNumberSprite; // 左上角小数字精灵
     cocos2d::Sprite* _suitSprite;       // 左上角花色精灵
     cocos2d::Sprite* _bigNumberSprite;  // 中央大数字精灵
+    cocos2d::Sprite* _faceSprite;       // 图集中的整张牌面精灵（使用图集时其余精灵为空）
     cocos2d::Size _cardSize;            // 卡牌尺寸
+    bool _culled;                       // 是否被父视图裁剪
 };
 
 #endif // __CARD_VIEW_H__
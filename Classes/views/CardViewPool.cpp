@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "CardViewPool.h"
+#include "../models/CardModel.h"
+
+CardViewPool::CardViewPool()
+{
+}
+
+CardViewPool::~CardViewPool()
+{
+    clear();
+}
+
+CardView* CardViewPool::acquire(const CardModel* cardModel)
+{
+    if (cardModel == nullptr)
+    {
+        return nullptr;
+    }
+    
+    if (_freeCardViews.empty())
+    {
+        return CardView::create(cardModel);
+    }
+    
+    // 与create返回的视图一样交给autorelease，由加入的父节点持有
+    CardView* cardView = _freeCardViews.back();
+    cardView->retain();
+    _freeCardViews.popBack();
+    cardView->autorelease();
+    cardView->rebind(cardModel);
+    return cardView;
+}
+
+void CardViewPool::recycle(CardView* cardView)
+{
+    if (cardView == nullptr)
+    {
+        return;
+    }
+    
+    // 先放入池中持有引用，再从父节点移除（移除时停止所有动作和定时器）
+    _freeCardViews.pushBack(cardView);
+    cardView->removeFromParent();
+}
+
+void CardViewPool::clear()
+{
+    _freeCardViews.clear();
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CARD_VIEW_POOL_H__
+#define __CARD_VIEW_POOL_H__
+
+#include "cocos2d.h"
+#include "CardView.h"
+
+// 前向声明
+class CardModel;
+
+/**
+ * @brief 卡牌视图对象池
+ * 离开牌堆的卡牌视图回收到池中，下次需要时重新绑定卡牌数据后复用
+ * 重新开始游戏时卡牌视图全部回收再取出，不再重新创建卡牌及其子精灵
+ */
+class CardViewPool
+{
+public:
+    CardViewPool();
+    virtual ~CardViewPool();
+    
+    /**
+     * @brief 取出一个卡牌视图并绑定卡牌数据，池为空时创建新的
+     * @param cardModel 卡牌数据模型
+     * @return 卡牌视图（autorelease，由调用方加入父节点），失败返回nullptr
+     */
+    CardView* acquire(const CardModel* cardModel);
+    
+    /**
+     * @brief 回收卡牌视图：停止动作、从父节点移除并放回池中
+     * @param cardView 卡牌视图
+     */
+    void recycle(CardView* cardView);
+    
+    /**
+     * @brief 池中空闲的卡牌视图数量
+     */
+    ssize_t getFreeCount() const { return _freeCardViews.size(); }
+    
+    /**
+     * @brief 释放所有空闲的卡牌视图
+     */
+    void clear();
+
+private:
+    cocos2d::Vector<CardView*> _freeCardViews;   // 空闲的卡牌视图（池持有引用）
+};
+
+#endif // __CARD_VIEW_POOL_H__
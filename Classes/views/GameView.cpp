@@ -24,16 +24,23 @@
 
 #include "GameView.h"
 #include "../models/GameModel.h"
+#include "../utils/TraceRecorder.h"
 #include "GameResultView.h"
 #include "2d/CCLayer.h"
 #include "base/CCDirector.h"
 
 USING_NS_CC;
 
-GameView* GameView::create(const GameModel* gameModel)
+namespace
+{
+    const int HINT_ACTION_TAG = 0x4849;     // 卡牌提示动作的标签，重复提示时先停止上一次
+    const int TIP_LABEL_TAG = 0x5449;       // 文字提示的标签，同一时间只显示一条
+}
+
+GameView* GameView::create(const GameModel* gameModel, const PlayFieldLayout& playFieldLayout)
 {
     GameView* view = new GameView();
-    if (view && view->init(gameModel))
+    if (view && view->init(gameModel, playFieldLayout))
     {
         view->autorelease();
         return view;
@@ -42,7 +49,7 @@ GameView* GameView::create(const GameModel* gameModel)
     return nullptr;
 }
 
-bool GameView::init(const GameModel* gameModel)
+bool GameView::init(const GameModel* gameModel, const PlayFieldLayout& playFieldLayout)
 {
     if (!Scene::init() || gameModel == nullptr)
     {
@@ -54,6 +61,8 @@ bool GameView::init(const GameModel* gameModel)
     _stackView = nullptr;
     _bottomCardView = nullptr;
     _undoButton = nullptr;
+    _redoButton = nullptr;
+    _hintButton = nullptr;
     _gameResultView = nullptr;
     
     // 创建背景（分上下两个区域）
@@ -77,6 +86,8 @@ bool GameView::init(const GameModel* gameModel)
     {
         _playFieldView->setContentSize(Size(visibleSize.width, topAreaHeight));
         _playFieldView->setPosition(Vec2(0, visibleSize.height - topAreaHeight));
+        _playFieldView->setCardViewPool(&_cardViewPool);
+        _playFieldView->setLayout(playFieldLayout);
         this->addChild(_playFieldView, 1);
         // 设置完视图尺寸后，调用updateView确保位置正确
         _playFieldView->updateView(gameModel);
@@ -90,6 +101,7 @@ bool GameView::init(const GameModel* gameModel)
         float stackWidth = visibleSize.width * 0.5f;
         _stackView->setContentSize(Size(stackWidth, bottomAreaHeight));
         _stackView->setPosition(Vec2(100.0f, 0));  // 左下角
+        _stackView->setCardViewPool(&_cardViewPool);
         this->addChild(_stackView, 1);
         // 设置完视图尺寸后，调用updateView确保位置正确
         _stackView->updateView(gameModel);
@@ -103,6 +115,7 @@ bool GameView::init(const GameModel* gameModel)
         float bottomWidth = visibleSize.width * 0.5f;
         _bottomCardView->setContentSize(Size(bottomWidth, bottomAreaHeight));
         _bottomCardView->setPosition(Vec2(visibleSize.width * 0.5f, 0));  // 右下角
+        _bottomCardView->setCardViewPool(&_cardViewPool);
         this->addChild(_bottomCardView, 1);
         // 设置完视图尺寸后，调用updateView确保位置正确
         _bottomCardView->updateView(gameModel);
@@ -115,6 +128,8 @@ bool GameView::init(const GameModel* gameModel)
 
 void GameView::updateView(const GameModel* gameModel)
 {
+    TRACE_ZONE("GameView::updateView");
+    
     if (gameModel == nullptr)
     {
         return;
@@ -138,6 +153,29 @@ void GameView::updateView(const GameModel* gameModel)
     }
 }
 
+void GameView::rebuildView(const GameModel* gameModel)
+{
+    if (_playFieldView != nullptr)
+    {
+        _playFieldView->clearCardViews();
+    }
+    
+    if (_stackView != nullptr)
+    {
+        _stackView->clearCardViews();
+    }
+    
+    updateView(gameModel);
+}
+
+void GameView::setPlayFieldLayout(const PlayFieldLayout& playFieldLayout)
+{
+    if (_playFieldView != nullptr)
+    {
+        _playFieldView->setLayout(playFieldLayout);
+    }
+}
+
 void GameView::setUndoButtonCallback(const std::function<void()>& callback)
 {
     _undoButtonCallback = callback;
@@ -168,6 +206,44 @@ void GameView::initUI()
         menu->setPosition(Vec2::ZERO);
         this->addChild(menu, 10);
     }
+    
+    // 创建重做按钮（回退按钮左侧）
+    auto redoLabel = Label::createWithSystemFont("重做", "", 48);
+    if (redoLabel == nullptr)
+    {
+        redoLabel = Label::createWithTTF("重做", "fonts/Marker Felt.ttf", 48);
+    }
+    
+    if (redoLabel != nullptr)
+    {
+        redoLabel->setColor(Color3B::WHITE);  // 白色文字
+        _redoButton = MenuItemLabel::create(redoLabel,
+                                            CC_CALLBACK_1(GameView::onRedoButtonClicked, this));
+        _redoButton->setPosition(Vec2(visibleSize.width - 250, 100));
+        
+        auto menu = Menu::create(_redoButton, nullptr);
+        menu->setPosition(Vec2::ZERO);
+        this->addChild(menu, 10);
+    }
+    
+    // 创建提示按钮（重做按钮左侧）
+    auto hintLabel = Label::createWithSystemFont("提示", "", 48);
+    if (hintLabel == nullptr)
+    {
+        hintLabel = Label::createWithTTF("提示", "fonts/Marker Felt.ttf", 48);
+    }
+    
+    if (hintLabel != nullptr)
+    {
+        hintLabel->setColor(Color3B::WHITE);  // 白色文字
+        _hintButton = MenuItemLabel::create(hintLabel,
+                                            CC_CALLBACK_1(GameView::onHintButtonClicked, this));
+        _hintButton->setPosition(Vec2(visibleSize.width - 400, 100));
+        
+        auto menu = Menu::create(_hintButton, nullptr);
+        menu->setPosition(Vec2::ZERO);
+        this->addChild(menu, 10);
+    }
 }
 
 void GameView::onUndoButtonClicked(Ref* sender)
@@ -178,6 +254,65 @@ void GameView::onUndoButtonClicked(Ref* sender)
     }
 }
 
+void GameView::onRedoButtonClicked(Ref* sender)
+{
+    if (_redoButtonCallback != nullptr)
+    {
+        _redoButtonCallback();
+    }
+}
+
+void GameView::onHintButtonClicked(Ref* sender)
+{
+    if (_hintButtonCallback != nullptr)
+    {
+        _hintButtonCallback();
+    }
+}
+
+void GameView::highlightCard(int cardId)
+{
+    CardView* cardView = nullptr;
+    if (_playFieldView != nullptr)
+    {
+        cardView = _playFieldView->getCardView(cardId);
+    }
+    if (cardView == nullptr && _stackView != nullptr)
+    {
+        cardView = _stackView->getCardView(cardId);
+    }
+    if (cardView == nullptr)
+    {
+        return;
+    }
+    
+    // 放大缩小闪烁两次，最后恢复原始大小
+    cardView->stopActionByTag(HINT_ACTION_TAG);
+    cardView->setScale(1.0f);
+    auto pulse = Sequence::create(ScaleTo::create(0.15f, 1.15f), ScaleTo::create(0.15f, 1.0f), nullptr);
+    auto action = Repeat::create(pulse, 2);
+    action->setTag(HINT_ACTION_TAG);
+    cardView->runAction(action);
+}
+
+void GameView::showTip(const std::string& text)
+{
+    this->removeChildByTag(TIP_LABEL_TAG);
+    
+    auto tipLabel = Label::createWithSystemFont(text, "", 48);
+    if (tipLabel == nullptr)
+    {
+        return;
+    }
+    
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    tipLabel->setColor(Color3B::WHITE);
+    tipLabel->setPosition(Vec2(visibleSize.width * 0.5f, visibleSize.height * 0.5f));
+    tipLabel->setTag(TIP_LABEL_TAG);
+    this->addChild(tipLabel, 20);
+    tipLabel->runAction(Sequence::create(DelayTime::create(1.0f), FadeOut::create(0.5f), RemoveSelf::create(), nullptr));
+}
+
 void GameView::showGameResult(GameResultType resultType)
 {
     // 如果已经显示了结果弹窗，不再重复显示
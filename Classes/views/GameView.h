@@ -30,6 +30,7 @@
 #include "StackView.h"
 #include "BottomCardView.h"
 #include "GameResultView.h"
+#include "CardViewPool.h"
 
 // 前向声明
 class GameModel;
@@ -44,16 +45,18 @@ public:
     /**
      * @brief 创建游戏视图
      * @param gameModel 游戏模型（const指针）
+     * @param playFieldLayout 主牌区布局
      * @return 游戏视图对象
      */
-    static GameView* create(const GameModel* gameModel);
+    static GameView* create(const GameModel* gameModel, const PlayFieldLayout& playFieldLayout);
     
     /**
      * @brief 初始化
      * @param gameModel 游戏模型
+     * @param playFieldLayout 主牌区布局
      * @return 是否成功
      */
-    bool init(const GameModel* gameModel);
+    bool init(const GameModel* gameModel, const PlayFieldLayout& playFieldLayout);
     
     /**
      * @brief 获取主牌堆视图
@@ -76,12 +79,48 @@ public:
      */
     void updateView(const GameModel* gameModel);
     
+    /**
+     * @brief 回收现有卡牌视图并按model重建（恢复快照、重新开始等整体替换牌局数据时使用）
+     * 卡牌视图来自对象池，重建时不创建新节点
+     * @param gameModel 游戏模型
+     */
+    void rebuildView(const GameModel* gameModel);
+    
+    /**
+     * @brief 设置主牌区布局（切换关卡时在rebuildView之前调用）
+     */
+    void setPlayFieldLayout(const PlayFieldLayout& playFieldLayout);
+    
     /**
      * @brief 设置回退按钮点击回调
      * @param callback 回调函数
      */
     void setUndoButtonCallback(const std::function<void()>& callback);
     
+    /**
+     * @brief 设置重做按钮点击回调
+     * @param callback 回调函数
+     */
+    void setRedoButtonCallback(const std::function<void()>& callback) { _redoButtonCallback = callback; }
+    
+    /**
+     * @brief 设置提示按钮点击回调
+     * @param callback 回调函数
+     */
+    void setHintButtonCallback(const std::function<void()>& callback) { _hintButtonCallback = callback; }
+    
+    /**
+     * @brief 闪烁提示一张卡牌（主牌区或备用牌堆中的卡牌）
+     * @param cardId 卡牌ID
+     */
+    void highlightCard(int cardId);
+    
+    /**
+     * @brief 在屏幕中央显示一条短暂的文字提示
+     * @param text 提示文字
+     */
+    void showTip(const std::string& text);
+    
     /**
      * @brief 显示游戏结果弹窗
      * @param resultType 游戏结果类型（成功/失败）
@@ -116,12 +155,27 @@ private:
      */
     void onUndoButtonClicked(cocos2d::Ref* sender);
     
+    /**
+     * @brief 重做按钮点击处理
+     */
+    void onRedoButtonClicked(cocos2d::Ref* sender);
+    
+    /**
+     * @brief 提示按钮点击处理
+     */
+    void onHintButtonClicked(cocos2d::Ref* sender);
+    
     const GameModel* _gameModel;                     // 游戏模型（const指针）
     PlayFieldView* _playFieldView;                    // 主牌堆视图
     StackView* _stackView;                            // 备用牌堆视图
     BottomCardView* _bottomCardView;                  // 底牌视图
+    CardViewPool _cardViewPool;                       // 卡牌视图对象池（各牌堆视图共用）
     cocos2d::MenuItemLabel* _undoButton;              // 回退按钮
     std::function<void()> _undoButtonCallback;        // 回退按钮回调
+    cocos2d::MenuItemLabel* _redoButton;              // 重做按钮
+    std::function<void()> _redoButtonCallback;        // 重做按钮回调
+    cocos2d::MenuItemLabel* _hintButton;              // 提示按钮
+    std::function<void()> _hintButtonCallback;        // 提示按钮回调
     std::function<void()> _restartCallback;           // 重新开始回调
     std::function<void()> _exitCallback;              // 退出回调
     GameResultView* _gameResultView;                  // 游戏结果弹窗
@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "LoadingView.h"
+#include "2d/CCLayer.h"
+#include "2d/CCLabel.h"
+#include "base/CCDirector.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+namespace
+{
+    const float PROGRESS_BAR_WIDTH = 720.0f;    // 进度条宽度
+    const float PROGRESS_BAR_HEIGHT = 36.0f;    // 进度条高度
+}
+
+LoadingView* LoadingView::create()
+{
+    LoadingView* view = new LoadingView();
+    if (view && view->init())
+    {
+        view->autorelease();
+        return view;
+    }
+    delete view;
+    return nullptr;
+}
+
+bool LoadingView::init()
+{
+    if (!Scene::init())
+    {
+        return false;
+    }
+    
+    _progressBar = nullptr;
+    _progressLabel = nullptr;
+    
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    
+    // 背景与游戏场景下方区域同色
+    auto background = LayerColor::create(Color4B(128, 0, 128, 255), visibleSize.width, visibleSize.height);
+    background->setPosition(Vec2::ZERO);
+    this->addChild(background, 0);
+    
+    std::string titleText("\xe5\x8a\xa0\xe8\xbd\xbd\xe4\xb8\xad");  // "加载中" UTF-8编码
+    auto titleLabel = Label::createWithSystemFont(titleText, "", 64);
+    if (titleLabel == nullptr)
+    {
+        titleLabel = Label::createWithTTF(titleText, "fonts/Marker Felt.ttf", 64);
+    }
+    if (titleLabel != nullptr)
+    {
+        titleLabel->setColor(Color3B::WHITE);
+        titleLabel->setPosition(Vec2(visibleSize.width / 2, visibleSize.height * 0.55f));
+        this->addChild(titleLabel, 1);
+    }
+    
+    // 进度条：底槽 + 从左向右缩放的填充条
+    Vec2 barOrigin((visibleSize.width - PROGRESS_BAR_WIDTH) / 2, visibleSize.height * 0.45f);
+    auto barTrack = LayerColor::create(Color4B(80, 0, 80, 255), PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT);
+    barTrack->setPosition(barOrigin);
+    this->addChild(barTrack, 1);
+    
+    _progressBar = LayerColor::create(Color4B(210, 180, 140, 255), PROGRESS_BAR_WIDTH, PROGRESS_BAR_HEIGHT);
+    _progressBar->setIgnoreAnchorPointForPosition(false);
+    _progressBar->setAnchorPoint(Vec2::ZERO);
+    _progressBar->setPosition(barOrigin);
+    this->addChild(_progressBar, 2);
+    
+    _progressLabel = Label::createWithSystemFont("0%", "", 40);
+    if (_progressLabel != nullptr)
+    {
+        _progressLabel->setColor(Color3B::WHITE);
+        _progressLabel->setPosition(Vec2(visibleSize.width / 2, barOrigin.y - 50.0f));
+        this->addChild(_progressLabel, 1);
+    }
+    
+    setProgress(0.0f);
+    return true;
+}
+
+void LoadingView::setProgress(float progress)
+{
+    progress = std::min(1.0f, std::max(0.0f, progress));
+    
+    if (_progressBar != nullptr)
+    {
+        _progressBar->setScaleX(progress);
+    }
+    
+    if (_progressLabel != nullptr)
+    {
+        _progressLabel->setString(std::to_string((int)(progress * 100.0f + 0.5f)) + "%");
+    }
+}
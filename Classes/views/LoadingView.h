@@ -0,0 +1,61 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __LOADING_VIEW_H__
+#define __LOADING_VIEW_H__
+
+#include "cocos2d.h"
+
+/**
+ * @brief 加载场景视图
+ * 显示标题、进度条和百分比，进度由LoadingController在每张纹理加载完成后设置
+ */
+class LoadingView : public cocos2d::Scene
+{
+public:
+    /**
+     * @brief 创建加载场景
+     * @return 加载场景对象
+     */
+    static LoadingView* create();
+    
+    /**
+     * @brief 初始化
+     * @return 是否成功
+     */
+    virtual bool init() override;
+    
+    /**
+     * @brief 设置加载进度
+     * @param progress 进度（0~1）
+     */
+    void setProgress(float progress);
+
+private:
+    cocos2d::LayerColor* _progressBar;      // 进度条（按进度横向缩放）
+    cocos2d::Label* _progressLabel;         // 百分比文字
+};
+
+#endif // __LOADING_VIEW_H__
@@ -25,8 +25,13 @@
 #include "PlayFieldView.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
+#include "../utils/TraceRecorder.h"
+#include "CardViewPool.h"
 #include "base/CCEventListenerTouch.h"
 #include "base/CCEventDispatcher.h"
+#include "base/CCDirector.h"
+#include <algorithm>
+#include <cmath>
 
 USING_NS_CC;
 
@@ -50,10 +55,12 @@ bool PlayFieldView::init(const GameModel* gameModel)
     }
     
     _gameModel = gameModel;
-    _cardSize = Size(100, 140);
-    // 卡牌间距：分散排布，间距大一点
-    _cardSpacingX = 250.0f;  // 横向间距（增大间距）
-    _cardSpacingY = 400.0f;  // 纵向间距（增大间距）
+    // 视图与牌局同生命周期，不注销读者（控制器先于场景释放牌局）
+    _zoneChangeReader = gameModel->addZoneChangeReader();
+    _appliedChangeSequence = 0;
+    _appliedChangeEpoch = 0;
+    _cardViewPool = nullptr;
+    _needsRebuild = true;
     
     // 设置触摸监听
     auto listener = EventListenerTouchOneByOne::create();
@@ -67,109 +74,157 @@ bool PlayFieldView::init(const GameModel* gameModel)
     return true;
 }
 
+void PlayFieldView::clearCardViews()
+{
+    for (auto& pair : _cardViews)
+    {
+        releaseCardView(pair.second);
+    }
+    _cardViews.clear();
+    _cardOriginalIndex.clear();
+    _hitTestGrid.clear();
+    _needsRebuild = true;
+}
+
+void PlayFieldView::setLayout(const PlayFieldLayout& layout)
+{
+    _layout = layout;
+    _needsRebuild = true;
+}
+
 void PlayFieldView::updateView(const GameModel* gameModel)
 {
+    TRACE_ZONE("PlayFieldView::updateView");
+    
     if (gameModel == nullptr)
     {
         return;
     }
     
-    _gameModel = gameModel;
-    
-    const std::vector<int>& playFieldCardIds = gameModel->getPlayFieldCardIds();
+    // 同一牌局且尚未处理的区域变化都还保留时只处理新增的变化，否则按牌堆整体重建
+    bool canApplyChanges = !_needsRebuild && gameModel == _gameModel && gameModel->isZoneChangeTracking()
+        && gameModel->getZoneChangeEpoch() == _appliedChangeEpoch
+        && _appliedChangeSequence >= gameModel->getZoneChangeBegin() && _appliedChangeSequence <= gameModel->getZoneChangeEnd();
     
-    // 先创建第一张卡牌，获取实际卡牌尺寸（如果还没有获取）
-    if (!playFieldCardIds.empty() && _cardSize.width <= 0)
+    if (gameModel != _gameModel)
     {
-        int firstCardId = playFieldCardIds[0];
-        const CardModel* firstCardModel = gameModel->getCardById(firstCardId);
-        if (firstCardModel != nullptr)
-        {
-            CardView* tempCardView = CardView::create(firstCardModel);
-            if (tempCardView != nullptr)
-            {
-                _cardSize = tempCardView->getCardSize();
-                tempCardView->removeFromParent();
-                tempCardView->release();  // 释放临时创建的卡牌
-            }
-        }
+        _gameModel = gameModel;
+        _zoneChangeReader = gameModel->addZoneChangeReader();
     }
-    
-    // 如果是首次创建，记录所有卡牌的原始索引
-    if (_cardOriginalIndex.empty() && !playFieldCardIds.empty())
+    if (canApplyChanges)
     {
-        for (size_t i = 0; i < playFieldCardIds.size(); ++i)
+        for (size_t sequence = _appliedChangeSequence; sequence < gameModel->getZoneChangeEnd(); ++sequence)
         {
-            _cardOriginalIndex[playFieldCardIds[i]] = (int)i;
+            applyZoneChange(gameModel, gameModel->getZoneChange(sequence));
         }
     }
-    
-    // 移除已不存在的卡牌视图
-    std::vector<int> cardsToRemove;
-    for (auto& pair : _cardViews)
+    else
     {
-        int cardId = pair.first;
-        if (std::find(playFieldCardIds.begin(), playFieldCardIds.end(), cardId) == playFieldCardIds.end())
-        {
-            cardsToRemove.push_back(cardId);
-        }
+        rebuildCardViews(gameModel);
     }
-    for (int cardId : cardsToRemove)
+    
+    // 确认已处理的变化，所有读者都处理过的变化由模型丢弃
+    _appliedChangeSequence = gameModel->getZoneChangeEnd();
+    _appliedChangeEpoch = gameModel->getZoneChangeEpoch();
+    gameModel->acknowledgeZoneChanges(_zoneChangeReader, _appliedChangeSequence);
+    _needsRebuild = false;
+}
+
+void PlayFieldView::applyZoneChange(const GameModel* gameModel, const CardZoneChange& change)
+{
+    if (change.fromZone == CardZone::PLAY_FIELD)
     {
-        auto it = _cardViews.find(cardId);
+        _hitTestGrid.remove(change.cardId);
+        auto it = _cardViews.find(change.cardId);
         if (it != _cardViews.end())
         {
-            it->second->removeFromParent();
+            releaseCardView(it->second);
             _cardViews.erase(it);
         }
-        _cardOriginalIndex.erase(cardId);
     }
+    if (change.toZone == CardZone::PLAY_FIELD)
+    {
+        addCardView(gameModel, change.cardId, change.zoneIndex);
+    }
+}
+
+void PlayFieldView::rebuildCardViews(const GameModel* gameModel)
+{
+    for (auto& pair : _cardViews)
+    {
+        releaseCardView(pair.second);
+    }
+    _cardViews.clear();
+    _hitTestGrid.clear();
     
-    // 创建或更新现有卡牌视图，使用原始索引计算位置
-    for (size_t i = 0; i < playFieldCardIds.size(); ++i)
+    const std::vector<int>& cardIds = gameModel->getPlayFieldCardIds();
+    
+    // 如果是首次创建，记录所有卡牌的原始索引（卡牌离开后保留，回退时回到原位置）
+    if (_cardOriginalIndex.empty())
     {
-        int cardId = playFieldCardIds[i];
-        const CardModel* cardModel = gameModel->getCardById(cardId);
-        if (cardModel == nullptr)
-        {
-            continue;
-        }
-        
-        // 如果卡牌视图不存在，创建它
-        auto it = _cardViews.find(cardId);
-        if (it == _cardViews.end())
+        for (size_t i = 0; i < cardIds.size(); ++i)
         {
-            CardView* cardView = CardView::create(cardModel);
-            if (cardView != nullptr)
-            {
-                // 如果这是第一张卡牌，更新卡牌尺寸
-                if (i == 0 && _cardSize.width <= 0)
-                {
-                    _cardSize = cardView->getCardSize();
-                }
-                
-                // 获取原始索引（如果不存在，使用当前索引）
-                int originalIndex = _cardOriginalIndex.find(cardId) != _cardOriginalIndex.end() 
-                    ? _cardOriginalIndex[cardId] 
-                    : (int)i;
-                
-                Vec2 pos = getCardPosition(originalIndex);
-                cardView->setPosition(pos);
-                this->addChild(cardView);
-                _cardViews[cardId] = cardView;
-            }
+            _cardOriginalIndex[cardIds[i]] = (int)i;
         }
-        else
+        // 未设置布局或布局位置不足时按默认网格排布
+        if (_layout.slots.size() < cardIds.size())
         {
-            // 卡牌视图已存在，更新位置（使用原始索引）
-            CardView* cardView = it->second;
-            int originalIndex = _cardOriginalIndex.find(cardId) != _cardOriginalIndex.end() 
-                ? _cardOriginalIndex[cardId] 
-                : (int)i;
-            Vec2 pos = getCardPosition(originalIndex);
-            cardView->setPosition(pos);
+            PlayFieldLayoutGenerator::generateLayout(PlayFieldLayoutConfig(), (int)cardIds.size(),
+                                                     std::vector<PlayFieldCoverConfig>(), _layout);
         }
     }
+    
+    for (size_t i = 0; i < cardIds.size(); ++i)
+    {
+        addCardView(gameModel, cardIds[i], (int)i);
+    }
+}
+
+void PlayFieldView::addCardView(const GameModel* gameModel, int cardId, int zoneIndex)
+{
+    const CardModel* cardModel = gameModel->getCardById(cardId);
+    if (cardModel == nullptr)
+    {
+        return;
+    }
+    
+    // 获取原始索引（如果不存在，使用进入牌堆时的位置）
+    auto indexIt = _cardOriginalIndex.find(cardId);
+    if (indexIt == _cardOriginalIndex.end())
+    {
+        indexIt = _cardOriginalIndex.insert(std::make_pair(cardId, std::max(0, zoneIndex))).first;
+    }
+    int originalIndex = indexIt->second;
+    // 压住其他牌的卡牌绘制在上层，点击检测同样按层级取最上层
+    int layer = originalIndex < (int)_layout.slots.size() ? _layout.slots[originalIndex].layer : 0;
+    
+    auto it = _cardViews.find(cardId);
+    if (it != _cardViews.end())
+    {
+        CardView* cardView = it->second;
+        cardView->setPosition(getCardPosition(originalIndex));
+        cardView->setLocalZOrder(layer);
+        updateHitRect(cardId, cardView);
+        return;
+    }
+    
+    CardView* cardView = acquireCardView(cardModel);
+    if (cardView != nullptr)
+    {
+        cardView->setPosition(getCardPosition(originalIndex));
+        this->addChild(cardView, layer);
+        _cardViews[cardId] = cardView;
+        updateHitRect(cardId, cardView);
+    }
+}
+
+void PlayFieldView::updateHitRect(int cardId, CardView* cardView)
+{
+    // 卡牌锚点在中心，层级与节点绘制顺序一致
+    Vec2 cardPos = cardView->getPosition();
+    Size cardSize = cardView->getCardSize();
+    _hitTestGrid.insert(cardId, cardPos.x - cardSize.width / 2, cardPos.y - cardSize.height / 2,
+                        cardSize.width, cardSize.height, cardView->getLocalZOrder());
 }
 
 void PlayFieldView::playCardMoveAnimation(int cardId, const Vec2& targetPos, 
@@ -178,7 +233,19 @@ void PlayFieldView::playCardMoveAnimation(int cardId, const Vec2& targetPos,
     CardView* cardView = getCardView(cardId);
     if (cardView != nullptr)
     {
-        cardView->playMoveAnimation(targetPos, duration, callback);
+        // 移动中的卡牌不响应点击，到达后按新位置重新登记（期间被移除则不再登记）
+        _hitTestGrid.remove(cardId);
+        cardView->playMoveAnimation(targetPos, duration, [this, cardId, callback]() {
+            CardView* movedCardView = getCardView(cardId);
+            if (movedCardView != nullptr)
+            {
+                updateHitRect(cardId, movedCardView);
+            }
+            if (callback != nullptr)
+            {
+                callback();
+            }
+        });
     }
 }
 
@@ -188,7 +255,19 @@ void PlayFieldView::playUndoAnimation(int cardId, const Vec2& targetPos,
     CardView* cardView = getCardView(cardId);
     if (cardView != nullptr)
     {
-        cardView->playMoveAnimation(targetPos, duration, callback);
+        // 移动中的卡牌不响应点击，到达后按新位置重新登记（期间被移除则不再登记）
+        _hitTestGrid.remove(cardId);
+        cardView->playMoveAnimation(targetPos, duration, [this, cardId, callback]() {
+            CardView* movedCardView = getCardView(cardId);
+            if (movedCardView != nullptr)
+            {
+                updateHitRect(cardId, movedCardView);
+            }
+            if (callback != nullptr)
+            {
+                callback();
+            }
+        });
     }
 }
 
@@ -217,31 +296,17 @@ void PlayFieldView::onTouchEnded(Touch* touch, Event* event)
     Vec2 touchPos = touch->getLocation();
     Vec2 localPos = this->convertToNodeSpace(touchPos);
     
-    // 检查点击的是哪张卡牌
-    const std::vector<int>& playFieldCardIds = _gameModel->getPlayFieldCardIds();
-    for (int cardId : playFieldCardIds)
+    // 只检查触摸点所在格子中的卡牌，重叠时取最上层
+    int cardId = _hitTestGrid.queryTopmost(localPos.x, localPos.y);
+    if (cardId >= 0)
     {
-        CardView* cardView = getCardView(cardId);
-        if (cardView != nullptr)
-        {
-            Vec2 cardPos = cardView->getPosition();
-            Size cardSize = cardView->getCardSize();
-            Rect cardRect = Rect(cardPos.x - cardSize.width / 2,
-                                cardPos.y - cardSize.height / 2,
-                                cardSize.width, cardSize.height);
-            
-            if (cardRect.containsPoint(localPos))
-            {
-                _cardClickCallback(cardId);
-                break;
-            }
-        }
+        _cardClickCallback(cardId);
     }
 }
 
 Vec2 PlayFieldView::getCardPosition(int index)
 {
-    // 主牌堆：8张牌，矩形排布（2行4列），均匀排布，位于上方区域中间
+    // 布局坐标以主牌区中心为原点
     Size viewSize = this->getContentSize();
     
     // 如果视图尺寸无效，使用默认值
@@ -250,25 +315,95 @@ Vec2 PlayFieldView::getCardPosition(int index)
         viewSize = Size(1080, 1500);  // 默认尺寸
     }
     
-    // 固定2行4列布局
-    int cols = 4;  // 每行4张牌
-    int rows = 2;  // 共2行
-    
-    int row = index / cols;
-    int col = index % cols;
-    
-    // 计算总宽度和总高度（包括卡牌尺寸和间距）
-    float totalWidth = (cols - 1) * _cardSpacingX + _cardSize.width;
-    float totalHeight = (rows - 1) * _cardSpacingY + _cardSize.height;
+    Vec2 center(viewSize.width / 2.0f, viewSize.height / 2.0f);
+    if (index >= 0 && index < (int)_layout.slots.size())
+    {
+        return center + Vec2(_layout.slots[index].x, _layout.slots[index].y);
+    }
+    return center;
+}
+
+const PlayFieldSlot* PlayFieldView::getCardSlot(int cardId) const
+{
+    auto it = _cardOriginalIndex.find(cardId);
+    if (it == _cardOriginalIndex.end() || it->second >= (int)_layout.slots.size())
+    {
+        return nullptr;
+    }
+    return &_layout.slots[it->second];
+}
+
+void PlayFieldView::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (_visible)
+    {
+        updateCulling();
+    }
+    Layer::visit(renderer, parentTransform, parentFlags);
+}
+
+void PlayFieldView::updateCulling()
+{
+    // 屏幕可见区域换算到本地坐标
+    Director* director = Director::getInstance();
+    Vec2 visibleOrigin = director->getVisibleOrigin();
+    Size visibleSize = director->getVisibleSize();
+    Vec2 corner1 = this->convertToNodeSpace(visibleOrigin);
+    Vec2 corner2 = this->convertToNodeSpace(visibleOrigin + Vec2(visibleSize.width, visibleSize.height));
+    Rect visibleRect(std::min(corner1.x, corner2.x), std::min(corner1.y, corner2.y),
+                     std::fabs(corner2.x - corner1.x), std::fabs(corner2.y - corner1.y));
     
-    // 计算起始位置（在视图中间居中显示，均匀排布）
-    float startX = (viewSize.width - totalWidth) / 2.0f + _cardSize.width / 2.0f;
-    float startY = (viewSize.height + totalHeight) / 2.0f - _cardSize.height / 2.0f;  // 垂直居中
+    // 停在原位的卡牌才能挡住同位置的下层卡牌（移动动画中的卡牌不算）
+    Vec2 center = getCardPosition(-1);  // 主牌区中心
+    auto isAtSlot = [&center](const CardView* cardView, const PlayFieldSlot& slot) {
+        return cardView->getPosition().fuzzyEquals(center + Vec2(slot.x, slot.y), 0.5f);
+    };
     
-    // 均匀排布：每张牌的位置基于起始位置和间距计算
-    float x = startX + col * _cardSpacingX;
-    float y = startY - row * _cardSpacingY;
+    _overlapTopLayers.assign(_layout.overlapGroupCount, -1);
+    for (auto& pair : _cardViews)
+    {
+        const PlayFieldSlot* slot = getCardSlot(pair.first);
+        if (slot != nullptr && slot->overlapGroup >= 0 && isAtSlot(pair.second, *slot))
+        {
+            int& topLayer = _overlapTopLayers[slot->overlapGroup];
+            topLayer = std::max(topLayer, slot->layer);
+        }
+    }
     
-    return Vec2(x, y);
+    for (auto& pair : _cardViews)
+    {
+        CardView* cardView = pair.second;
+        const PlayFieldSlot* slot = getCardSlot(pair.first);
+        bool covered = slot != nullptr && slot->overlapGroup >= 0 && slot->layer < _overlapTopLayers[slot->overlapGroup]
+            && isAtSlot(cardView, *slot);
+        
+        Vec2 cardPos = cardView->getPosition();
+        Size cardSize = cardView->getCardSize();
+        float width = cardSize.width * std::fabs(cardView->getScaleX());
+        float height = cardSize.height * std::fabs(cardView->getScaleY());
+        Rect cardRect(cardPos.x - width / 2, cardPos.y - height / 2, width, height);
+        
+        cardView->setCulled(covered || !visibleRect.intersectsRect(cardRect));
+    }
+}
+
+CardView* PlayFieldView::acquireCardView(const CardModel* cardModel)
+{
+    if (_cardViewPool != nullptr)
+    {
+        return _cardViewPool->acquire(cardModel);
+    }
+    return CardView::create(cardModel);
 }
 
+void PlayFieldView::releaseCardView(CardView* cardView)
+{
+    if (_cardViewPool != nullptr)
+    {
+        _cardViewPool->recycle(cardView);
+    }
+    else
+    {
+        cardView->removeFromParent();
+    }
+}
@@ -27,15 +27,20 @@
 
 #include "cocos2d.h"
 #include "CardView.h"
+#include "../services/PlayFieldLayoutGenerator.h"
+#include "../utils/HitTestGrid.h"
 #include <vector>
 #include <map>
 
 // 前向声明
 class GameModel;
+class CardViewPool;
+struct CardZoneChange;
 
 /**
  * @brief 主牌区视图
  * 负责主牌区的UI显示和用户交互
+ * 卡牌按关卡布局摆放，层级由遮挡关系决定；每帧遍历前裁剪屏幕外和被同位置上层卡牌完全挡住的卡牌
  */
 class PlayFieldView : public cocos2d::Layer
 {
@@ -65,14 +70,27 @@ public:
      */
     void setCardClickCallback(const CardClickCallback& callback) { _cardClickCallback = callback; }
     
+    /**
+     * @brief 设置主牌区布局（下次updateView时按新布局重建；未设置时使用默认网格）
+     * @param layout 由PlayFieldLayoutGenerator生成的布局
+     */
+    void setLayout(const PlayFieldLayout& layout);
+    
     /**
      * @brief 更新显示（根据model更新UI）
+     * 只处理上次更新以来的区域变化，一次操作只增删对应的一两个卡牌视图；
+     * 首次调用、clearCardViews之后或模型未记录区域变化时按主牌堆整体重建
      * @param gameModel 游戏模型
      */
     void updateView(const GameModel* gameModel);
     
     /**
-     * @brief 播放卡牌平移动画（用于匹配替换）
+     * @brief 移除所有卡牌视图和原始索引（牌局数据整体替换时使用，之后调用updateView重建）
+     */
+    void clearCardViews();
+    
+    /**
+     * @brief 播放卡牌平移动画（用于匹配替换），移动期间该卡牌不响应点击
      * @param cardId 卡牌ID
      * @param targetPos 目标位置
      * @param duration 动画时长
@@ -82,7 +100,7 @@ public:
                               float duration, const std::function<void()>& callback = nullptr);
     
     /**
-     * @brief 播放回退动画
+     * @brief 播放回退动画，移动期间该卡牌不响应点击
      * @param cardId 卡牌ID
      * @param targetPos 目标位置（原位置）
      * @param duration 动画时长
@@ -97,8 +115,25 @@ public:
      * @return 卡牌视图，不存在返回nullptr
      */
     CardView* getCardView(int cardId);
+    
+    /**
+     * @brief 设置卡牌视图对象池（不持有），设置后卡牌视图从池中取出、移除时回收到池中
+     */
+    void setCardViewPool(CardViewPool* cardViewPool) { _cardViewPool = cardViewPool; }
+    
+    using cocos2d::Node::visit;
+    /**
+     * @brief 遍历前更新卡牌的裁剪状态
+     */
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
 
 private:
+    /**
+     * @brief 从对象池取出（未设置对象池时创建）/ 回收（未设置对象池时直接移除）卡牌视图
+     */
+    CardView* acquireCardView(const CardModel* cardModel);
+    void releaseCardView(CardView* cardView);
+    
     /**
      * @brief 处理触摸事件
      */
@@ -107,18 +142,54 @@ private:
     
     /**
      * @brief 获取卡牌位置
-     * @param index 卡牌在主牌堆中的索引
-     * @return 卡牌位置
+     * @param index 卡牌在主牌堆中的原始索引（布局位置下标）
+     * @return 卡牌位置，索引越界时返回主牌区中心
      */
     cocos2d::Vec2 getCardPosition(int index);
     
+    /**
+     * @brief 获取卡牌对应的布局位置，没有时返回nullptr
+     */
+    const PlayFieldSlot* getCardSlot(int cardId) const;
+    
+    /**
+     * @brief 裁剪屏幕外的卡牌，以及重合位置中被停在原位的上层卡牌完全挡住的卡牌
+     */
+    void updateCulling();
+    
+    /**
+     * @brief 处理一次区域变化：离开主牌堆则移除卡牌视图，进入主牌堆则创建
+     */
+    void applyZoneChange(const GameModel* gameModel, const CardZoneChange& change);
+    
+    /**
+     * @brief 按主牌堆当前内容重建所有卡牌视图
+     */
+    void rebuildCardViews(const GameModel* gameModel);
+    
+    /**
+     * @brief 创建卡牌视图并放到原始索引对应的位置（已存在时只更新位置）
+     * @param zoneIndex 没有原始索引时使用的位置
+     */
+    void addCardView(const GameModel* gameModel, int cardId, int zoneIndex);
+    
+    /**
+     * @brief 按卡牌视图当前位置登记点击区域
+     */
+    void updateHitRect(int cardId, CardView* cardView);
+    
     const GameModel* _gameModel;                     // 游戏模型（const指针）
+    int _zoneChangeReader;                            // 在游戏模型中登记的区域变化读者ID
+    size_t _appliedChangeSequence;                    // 已处理到的区域变化序号
+    unsigned int _appliedChangeEpoch;                 // 已处理的区域变化代数
+    bool _needsRebuild;                               // 下次更新是否整体重建
     std::map<int, CardView*> _cardViews;              // 卡牌视图映射（cardId -> CardView）
     std::map<int, int> _cardOriginalIndex;            // 卡牌原始索引映射（cardId -> originalIndex）
+    HitTestGrid _hitTestGrid;                         // 卡牌点击区域索引（本地坐标）
     CardClickCallback _cardClickCallback;            // 卡牌点击回调
-    cocos2d::Size _cardSize;                          // 卡牌尺寸
-    float _cardSpacingX;                               // 卡牌横向间距
-    float _cardSpacingY;                               // 卡牌纵向间距
+    CardViewPool* _cardViewPool;                      // 卡牌视图对象池（不持有，可为空）
+    PlayFieldLayout _layout;                          // 主牌区布局（按原始索引）
+    std::vector<int> _overlapTopLayers;               // 裁剪时每个重合分组中停在原位的最高层级
 };
 
 #endif // __PLAY_FIELD_VIEW_H__
@@ -25,8 +25,11 @@
 #include "StackView.h"
 #include "../models/GameModel.h"
 #include "../models/CardModel.h"
+#include "../utils/TraceRecorder.h"
+#include "CardViewPool.h"
 #include "base/CCEventListenerTouch.h"
 #include "base/CCEventDispatcher.h"
+#include <algorithm>
 
 USING_NS_CC;
 
@@ -50,6 +53,12 @@ bool StackView::init(const GameModel* gameModel)
     }
     
     _gameModel = gameModel;
+    // 视图与牌局同生命周期，不注销读者（控制器先于场景释放牌局）
+    _zoneChangeReader = gameModel->addZoneChangeReader();
+    _appliedChangeSequence = 0;
+    _appliedChangeEpoch = 0;
+    _cardViewPool = nullptr;
+    _needsRebuild = true;
     // 从第一张卡牌获取实际尺寸（如果存在）
     _cardSize = Size(100, 140);  // 默认值，会在updateView中更新
     _cardSpacing = 50.0f;  // 卡牌重叠间距
@@ -66,110 +75,119 @@ bool StackView::init(const GameModel* gameModel)
     return true;
 }
 
+void StackView::clearCardViews()
+{
+    for (auto& pair : _cardViews)
+    {
+        releaseCardView(pair.second);
+    }
+    _cardViews.clear();
+    _needsRebuild = true;
+}
+
 void StackView::updateView(const GameModel* gameModel)
 {
+    TRACE_ZONE("StackView::updateView");
+    
     if (gameModel == nullptr)
     {
         return;
     }
     
-    _gameModel = gameModel;
-    
-    const std::vector<int>& stackCardIds = gameModel->getStackCardIds();
+    // 同一牌局且尚未处理的区域变化都还保留时只处理新增的变化，否则按牌堆整体重建
+    bool canApplyChanges = !_needsRebuild && gameModel == _gameModel && gameModel->isZoneChangeTracking()
+        && gameModel->getZoneChangeEpoch() == _appliedChangeEpoch
+        && _appliedChangeSequence >= gameModel->getZoneChangeBegin() && _appliedChangeSequence <= gameModel->getZoneChangeEnd();
     
-    // 先创建第一张卡牌，获取实际卡牌尺寸（如果还没有获取）
-    if (!stackCardIds.empty() && _cardSize.width <= 0)
+    if (gameModel != _gameModel)
     {
-        int firstCardId = stackCardIds[0];
-        const CardModel* firstCardModel = gameModel->getCardById(firstCardId);
-        if (firstCardModel != nullptr)
-        {
-            CardView* tempCardView = CardView::create(firstCardModel);
-            if (tempCardView != nullptr)
-            {
-                _cardSize = tempCardView->getCardSize();
-                tempCardView->removeFromParent();
-                tempCardView->release();  // 释放临时创建的卡牌
-            }
-        }
+        _gameModel = gameModel;
+        _zoneChangeReader = gameModel->addZoneChangeReader();
     }
-    
-    // 如果是首次创建，记录所有卡牌的原始索引
-    if (_cardOriginalIndex.empty() && !stackCardIds.empty())
+    if (canApplyChanges)
     {
-        for (size_t i = 0; i < stackCardIds.size(); ++i)
+        for (size_t sequence = _appliedChangeSequence; sequence < gameModel->getZoneChangeEnd(); ++sequence)
         {
-            _cardOriginalIndex[stackCardIds[i]] = (int)i;
+            applyZoneChange(gameModel->getZoneChange(sequence));
         }
+        syncVisibleCards(gameModel);
     }
-    
-    // 移除已不存在的卡牌视图
-    std::vector<int> cardsToRemove;
-    for (auto& pair : _cardViews)
+    else
     {
-        int cardId = pair.first;
-        if (std::find(stackCardIds.begin(), stackCardIds.end(), cardId) == stackCardIds.end())
-        {
-            cardsToRemove.push_back(cardId);
-        }
+        rebuildCardViews(gameModel);
     }
-    for (int cardId : cardsToRemove)
+    
+    // 确认已处理的变化，所有读者都处理过的变化由模型丢弃
+    _appliedChangeSequence = gameModel->getZoneChangeEnd();
+    _appliedChangeEpoch = gameModel->getZoneChangeEpoch();
+    gameModel->acknowledgeZoneChanges(_zoneChangeReader, _appliedChangeSequence);
+    _needsRebuild = false;
+}
+
+void StackView::applyZoneChange(const CardZoneChange& change)
+{
+    if (change.fromZone == CardZone::STACK)
     {
-        auto it = _cardViews.find(cardId);
+        auto it = _cardViews.find(change.cardId);
         if (it != _cardViews.end())
         {
-            it->second->removeFromParent();
+            releaseCardView(it->second);
             _cardViews.erase(it);
         }
-        _cardOriginalIndex.erase(cardId);
     }
+}
+
+void StackView::rebuildCardViews(const GameModel* gameModel)
+{
+    for (auto& pair : _cardViews)
+    {
+        releaseCardView(pair.second);
+    }
+    _cardViews.clear();
     
-    // 创建或更新现有卡牌视图，使用原始索引计算位置
-    for (size_t i = 0; i < stackCardIds.size(); ++i)
+    syncVisibleCards(gameModel);
+}
+
+void StackView::syncVisibleCards(const GameModel* gameModel)
+{
+    const std::vector<int>& cardIds = gameModel->getStackCardIds();
+    int firstVisible = std::max(0, (int)cardIds.size() - MAX_VISIBLE_CARDS);
+    
+    // 回收已不在顶部窗口内的卡牌视图（窗口外的牌只会是被新牌压下去的）
+    for (auto it = _cardViews.begin(); it != _cardViews.end(); )
     {
-        int cardId = stackCardIds[i];
-        const CardModel* cardModel = gameModel->getCardById(cardId);
-        if (cardModel == nullptr)
+        int cardId = it->first;
+        bool visible = std::find(cardIds.begin() + firstVisible, cardIds.end(), cardId) != cardIds.end();
+        if (visible)
         {
+            ++it;
             continue;
         }
+        releaseCardView(it->second);
+        it = _cardViews.erase(it);
+    }
+    
+    for (int i = firstVisible; i < (int)cardIds.size(); ++i)
+    {
+        int cardId = cardIds[i];
+        Vec2 position = getCardPosition(i - firstVisible);
         
-        // 如果卡牌视图不存在，创建它
         auto it = _cardViews.find(cardId);
-        if (it == _cardViews.end())
+        if (it != _cardViews.end())
         {
-            CardView* cardView = CardView::create(cardModel);
-            if (cardView != nullptr)
-            {
-                // 如果这是第一张卡牌，更新卡牌尺寸
-                if (i == 0 && _cardSize.width <= 0)
-                {
-                    _cardSize = cardView->getCardSize();
-                }
-                
-                // 获取原始索引（如果不存在，使用当前索引）
-                int originalIndex = _cardOriginalIndex.find(cardId) != _cardOriginalIndex.end() 
-                    ? _cardOriginalIndex[cardId] 
-                    : (int)i;
-                
-                Vec2 pos = getCardPosition(originalIndex);
-                cardView->setPosition(pos);
-                // 设置Z轴顺序：后面的牌在上层（使用原始索引）
-                this->addChild(cardView, originalIndex);
-                _cardViews[cardId] = cardView;
-            }
+            it->second->setPosition(position);
+            it->second->setLocalZOrder(i);
+            continue;
         }
-        else
+        
+        const CardModel* cardModel = gameModel->getCardById(cardId);
+        CardView* cardView = cardModel != nullptr ? acquireCardView(cardModel) : nullptr;
+        if (cardView != nullptr)
         {
-            // 卡牌视图已存在，更新位置（使用原始索引）
-            CardView* cardView = it->second;
-            int originalIndex = _cardOriginalIndex.find(cardId) != _cardOriginalIndex.end() 
-                ? _cardOriginalIndex[cardId] 
-                : (int)i;
-            Vec2 pos = getCardPosition(originalIndex);
-            cardView->setPosition(pos);
-            // 更新Z轴顺序
-            cardView->setLocalZOrder(originalIndex);
+            cardView->setPosition(position);
+            // 设置Z轴顺序：后面的牌在上层
+            this->addChild(cardView, i);
+            _cardViews[cardId] = cardView;
         }
     }
 }
@@ -205,7 +223,7 @@ CardView* StackView::getCardView(int cardId)
 }
 
 
-Vec2 StackView::getCardPosition(int index)
+Vec2 StackView::getCardPosition(int slot)
 {
     // 备用牌堆：卡牌重叠显示，从左侧开始，与底牌保持水平对齐
     Size viewSize = this->getContentSize();
@@ -215,7 +233,7 @@ Vec2 StackView::getCardPosition(int index)
     
     // 卡牌重叠效果：每张牌向右偏移一定距离（约卡牌宽度的1/4）
     float overlapOffset = _cardSize.width * 0.25f;
-    float x = startX + index * overlapOffset;
+    float x = startX + slot * overlapOffset;
     float y = startY;  // 所有卡牌使用相同的Y坐标，保持水平对齐
     
     return Vec2(x, y);
@@ -261,3 +279,23 @@ void StackView::onTouchEnded(Touch* touch, Event* event)
     }
 }
 
+CardView* StackView::acquireCardView(const CardModel* cardModel)
+{
+    if (_cardViewPool != nullptr)
+    {
+        return _cardViewPool->acquire(cardModel);
+    }
+    return CardView::create(cardModel);
+}
+
+void StackView::releaseCardView(CardView* cardView)
+{
+    if (_cardViewPool != nullptr)
+    {
+        _cardViewPool->recycle(cardView);
+    }
+    else
+    {
+        cardView->removeFromParent();
+    }
+}
@@ -32,14 +32,19 @@
 
 // 前向声明
 class GameModel;
+class CardViewPool;
+struct CardZoneChange;
 
 /**
  * @brief 手牌区视图
  * 负责手牌区的UI显示和用户交互
+ * 只为顶部MAX_VISIBLE_CARDS张牌创建卡牌视图，更深的牌不显示也不实例化，牌堆大小不影响视图开销
  */
 class StackView : public cocos2d::Layer
 {
 public:
+    static const int MAX_VISIBLE_CARDS = 6;     // 同时显示的顶部卡牌数
+    
     /**
      * @brief 卡牌点击回调函数类型
      */
@@ -67,10 +72,17 @@ public:
     
     /**
      * @brief 更新显示（根据model更新UI）
+     * 只处理上次更新以来的区域变化，之后把顶部卡牌窗口同步到牌堆当前内容；
+     * 首次调用、clearCardViews之后或模型未记录区域变化时按备用牌堆整体重建
      * @param gameModel 游戏模型
      */
     void updateView(const GameModel* gameModel);
     
+    /**
+     * @brief 移除所有卡牌视图（牌局数据整体替换时使用，之后调用updateView重建）
+     */
+    void clearCardViews();
+    
     /**
      * @brief 播放卡牌平移动画（用于替换顶部牌）
      * @param cardId 卡牌ID
@@ -94,11 +106,22 @@ public:
     /**
      * @brief 获取卡牌视图
      * @param cardId 卡牌ID
-     * @return 卡牌视图，不存在返回nullptr
+     * @return 卡牌视图，不存在（包括不在顶部窗口内）返回nullptr
      */
     CardView* getCardView(int cardId);
+    
+    /**
+     * @brief 设置卡牌视图对象池（不持有），设置后卡牌视图从池中取出、移除时回收到池中
+     */
+    void setCardViewPool(CardViewPool* cardViewPool) { _cardViewPool = cardViewPool; }
 
 private:
+    /**
+     * @brief 从对象池取出（未设置对象池时创建）/ 回收（未设置对象池时直接移除）卡牌视图
+     */
+    CardView* acquireCardView(const CardModel* cardModel);
+    void releaseCardView(CardView* cardView);
+    
     /**
      * @brief 处理触摸事件
      */
@@ -107,15 +130,34 @@ private:
     
     /**
      * @brief 获取卡牌位置
-     * @param index 卡牌在备用牌堆中的索引（从底部到顶部）
+     * @param slot 卡牌在顶部窗口中的位置（从左到右，0为窗口最底部的牌）
      * @return 卡牌位置
      */
-    cocos2d::Vec2 getCardPosition(int index);
+    cocos2d::Vec2 getCardPosition(int slot);
+    
+    /**
+     * @brief 处理一次区域变化：离开备用牌堆则移除卡牌视图（进入的卡牌由syncVisibleCards创建）
+     */
+    void applyZoneChange(const CardZoneChange& change);
+    
+    /**
+     * @brief 移除所有卡牌视图后按备用牌堆当前内容重建顶部窗口
+     */
+    void rebuildCardViews(const GameModel* gameModel);
+    
+    /**
+     * @brief 把卡牌视图同步为备用牌堆顶部MAX_VISIBLE_CARDS张：移出窗口的回收，进入窗口的创建，其余只更新位置
+     */
+    void syncVisibleCards(const GameModel* gameModel);
     
     const GameModel* _gameModel;                     // 游戏模型（const指针）
-    std::map<int, CardView*> _cardViews;              // 卡牌视图映射（cardId -> CardView）
-    std::map<int, int> _cardOriginalIndex;            // 卡牌原始索引映射（cardId -> originalIndex）
+    int _zoneChangeReader;                            // 在游戏模型中登记的区域变化读者ID
+    size_t _appliedChangeSequence;                    // 已处理到的区域变化序号
+    unsigned int _appliedChangeEpoch;                 // 已处理的区域变化代数
+    bool _needsRebuild;                               // 下次更新是否整体重建
+    std::map<int, CardView*> _cardViews;              // 顶部窗口内的卡牌视图映射（cardId -> CardView）
     CardClickCallback _cardClickCallback;            // 卡牌点击回调
+    CardViewPool* _cardViewPool;                      // 卡牌视图对象池（不持有，可为空）
     cocos2d::Size _cardSize;                          // 卡牌尺寸
     float _cardSpacing;                               // 卡牌间距
 };
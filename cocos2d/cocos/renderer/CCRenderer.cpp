@@ -26,6 +26,7 @@
 #include "renderer/CCRenderer.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "renderer/CCTrianglesCommand.h"
 #include "renderer/CCBatchCommand.h"
@@ -51,14 +52,12 @@
 NS_CC_BEGIN
 
 // helper
-static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
+// Maps a float to an unsigned integer with the same ordering (negative values flipped, positive values offset)
+static inline uint32_t floatToSortKey(float value)
 {
-    return a->getGlobalOrder() < b->getGlobalOrder();
-}
-
-static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
-{
-    return  a->getDepth() > b->getDepth();
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
 }
 
 // queue
@@ -112,9 +111,77 @@ ssize_t RenderQueue::size() const
 void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]), std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]), compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
+    radixSort(_commands[QUEUE_GROUP::TRANSPARENT_3D], true);
+    radixSort(_commands[QUEUE_GROUP::GLOBALZ_NEG], false);
+    radixSort(_commands[QUEUE_GROUP::GLOBALZ_POS], false);
+}
+
+void RenderQueue::radixSort(std::vector<RenderCommand*>& commands, bool byDepth)
+{
+    const size_t count = commands.size();
+    if (count < 2)
+    {
+        return;
+    }
+
+    _sortKeys.resize(count);
+    _sortKeysScratch.resize(count);
+
+    // build keys and the histograms of all four bytes in one pass; most queues arrive already sorted
+    size_t histogram[4][256] = {};
+    bool sorted = true;
+    uint64_t previousKey = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        // back to front: larger depth first
+        uint32_t orderKey = byDepth ? ~floatToSortKey(commands[i]->getDepth()) : floatToSortKey(commands[i]->getGlobalOrder());
+        uint64_t key = (static_cast<uint64_t>(orderKey) << 32) | static_cast<uint32_t>(i);
+        sorted = sorted && key >= previousKey;
+        previousKey = key;
+        _sortKeys[i] = key;
+        ++histogram[0][orderKey & 0xFF];
+        ++histogram[1][(orderKey >> 8) & 0xFF];
+        ++histogram[2][(orderKey >> 16) & 0xFF];
+        ++histogram[3][orderKey >> 24];
+    }
+    if (sorted)
+    {
+        return;
+    }
+
+    // the insertion index in the low half is already ascending, so LSD passes over the high half keep ties stable
+    uint64_t* source = _sortKeys.data();
+    uint64_t* destination = _sortKeysScratch.data();
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        const int shift = 32 + pass * 8;
+        size_t* counts = histogram[pass];
+        if (counts[(source[0] >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            size_t digitCount = counts[digit];
+            counts[digit] = offset;
+            offset += digitCount;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t key = source[i];
+            destination[counts[(key >> shift) & 0xFF]++] = key;
+        }
+        std::swap(source, destination);
+    }
+
+    _sortedCommands.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        _sortedCommands[i] = commands[static_cast<uint32_t>(source[i])];
+    }
+    commands.swap(_sortedCommands);
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -199,6 +266,8 @@ static const int DEFAULT_RENDER_QUEUE = 0;
 //
 Renderer::Renderer()
 :_lastBatchedMeshCommand(nullptr)
+,_streamBufferIndex(0)
+,_streamVerticesMapped(false)
 ,_triBatchesToDrawCapacity(-1)
 ,_triBatchesToDraw(nullptr)
 ,_filledVertex(0)
@@ -231,13 +300,16 @@ Renderer::~Renderer()
     _renderGroups.clear();
     _groupCommandManager->release();
     
-    glDeleteBuffers(2, _buffersVBO);
+    for (int i = 0; i < STREAM_BUFFER_COUNT; ++i)
+    {
+        glDeleteBuffers(2, _buffersVBO[i]);
+    }
 
     free(_triBatchesToDraw);
 
     if (Configuration::getInstance()->supportsShareableVAO())
     {
-        glDeleteVertexArrays(1, &_buffersVAO);
+        glDeleteVertexArrays(STREAM_BUFFER_COUNT, _buffersVAO);
         GL::bindVAO(0);
     }
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -275,36 +347,39 @@ void Renderer::setupBuffer()
 
 void Renderer::setupVBOAndVAO()
 {
-    //generate vbo and vao for trianglesCommand
-    glGenVertexArrays(1, &_buffersVAO);
-    GL::bindVAO(_buffersVAO);
+    //generate vbo and vao for trianglesCommand, one pair per stream buffer set
+    glGenVertexArrays(STREAM_BUFFER_COUNT, _buffersVAO);
+    for (int i = 0; i < STREAM_BUFFER_COUNT; ++i)
+    {
+        GL::bindVAO(_buffersVAO[i]);
 
-    glGenBuffers(2, &_buffersVBO[0]);
+        glGenBuffers(2, _buffersVBO[i]);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    // Issue #15652
-    // Should not initialize VBO with a large size (VBO_SIZE=65536),
-    // it may cause low FPS on some Android devices like LG G4 & Nexus 5X.
-    // It's probably because some implementations of OpenGLES driver will
-    // copy the whole memory of VBO which initialized at the first time
-    // once glBufferData/glBufferSubData is invoked.
-    // For more discussion, please refer to https://github.com/cocos2d/cocos2d-x/issues/15652
-    //glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[i][0]);
+        // Issue #15652
+        // Should not initialize VBO with a large size (VBO_SIZE=65536),
+        // it may cause low FPS on some Android devices like LG G4 & Nexus 5X.
+        // It's probably because some implementations of OpenGLES driver will
+        // copy the whole memory of VBO which initialized at the first time
+        // once glBufferData/glBufferSubData is invoked.
+        // For more discussion, please refer to https://github.com/cocos2d/cocos2d-x/issues/15652
+        //glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
 
-    // vertices
-    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, vertices));
+        // vertices
+        glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, vertices));
 
-    // colors
-    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_COLOR);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, colors));
+        // colors
+        glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_COLOR);
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, colors));
 
-    // tex coords
-    glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORD);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
+        // tex coords
+        glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORD);
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[i][1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    }
 
     // Must unbind the VAO before changing the element buffer.
     GL::bindVAO(0);
@@ -316,7 +391,10 @@ void Renderer::setupVBOAndVAO()
 
 void Renderer::setupVBO()
 {
-    glGenBuffers(2, &_buffersVBO[0]);
+    for (int i = 0; i < STREAM_BUFFER_COUNT; ++i)
+    {
+        glGenBuffers(2, _buffersVBO[i]);
+    }
     // Issue #15652
     // Should not initialize VBO with a large size (VBO_SIZE=65536),
     // it may cause low FPS on some Android devices like LG G4 & Nexus 5X.
@@ -332,15 +410,16 @@ void Renderer::mapBuffers()
     // Avoid changing the element buffer for whatever VAO might be bound.
     GL::bindVAO(0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
-    
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    for (int i = 0; i < STREAM_BUFFER_COUNT; ++i)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[i][0]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[i][1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    }
 
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     CHECK_GL_ERROR_DEBUG();
@@ -390,18 +469,25 @@ void Renderer::processRenderCommand(RenderCommand* command)
 
         auto cmd = static_cast<TrianglesCommand*>(command);
         
-        // flush own queue when buffer is full
-        if(_filledVertex + cmd->getVertexCount() > VBO_SIZE || _filledIndex + cmd->getIndexCount() > INDEX_VBO_SIZE)
+        if(cmd->getVertexCount() > VBO_SIZE || cmd->getIndexCount() > INDEX_VBO_SIZE)
         {
-            CCASSERT(cmd->getVertexCount()>= 0 && cmd->getVertexCount() < VBO_SIZE, "VBO for vertex is not big enough, please break the data down or use customized render command");
-            CCASSERT(cmd->getIndexCount()>= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE, "VBO for index is not big enough, please break the data down or use customized render command");
+            // larger than a whole batch: draw what is queued, then draw this one alone in index chunks
             drawBatchedTriangles();
+            drawOversizedTriangles(cmd);
+        }
+        else
+        {
+            // flush own queue when buffer is full
+            if(_filledVertex + cmd->getVertexCount() > VBO_SIZE || _filledIndex + cmd->getIndexCount() > INDEX_VBO_SIZE)
+            {
+                drawBatchedTriangles();
+            }
+            
+            // queue it
+            _queuedTriangleCommands.push_back(cmd);
+            _filledIndex += cmd->getIndexCount();
+            _filledVertex += cmd->getVertexCount();
         }
-        
-        // queue it
-        _queuedTriangleCommands.push_back(cmd);
-        _filledIndex += cmd->getIndexCount();
-        _filledVertex += cmd->getVertexCount();
     }
     else if (RenderCommand::Type::MESH_COMMAND == commandType)
     {
@@ -706,16 +792,24 @@ void Renderer::setDepthTest(bool enable)
     CHECK_GL_ERROR_DEBUG();
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd)
+void Renderer::fillVertices(const TrianglesCommand* cmd, V3F_C4B_T2F* vertices, ssize_t vertexCount)
 {
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
-
-    // fill vertex, and convert them to world coordinates
+    // convert them to world coordinates while copying; the destination may be write-only mapped memory, so each
+    // vertex is written exactly once and never read back
+    const V3F_C4B_T2F* source = cmd->getVertices();
     const Mat4& modelView = cmd->getModelView();
-    for(ssize_t i=0; i < cmd->getVertexCount(); ++i)
+    for(ssize_t i=0; i < vertexCount; ++i)
     {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        V3F_C4B_T2F vertex = source[i];
+        modelView.transformPoint(&vertex.vertices);
+        vertices[i] = vertex;
     }
+}
+
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, V3F_C4B_T2F* vertices)
+{
+    // fill vertex
+    fillVertices(cmd, vertices + _filledVertex, cmd->getVertexCount());
 
     // fill index
     const unsigned short* indices = cmd->getIndices();
@@ -728,6 +822,93 @@ void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd)
     _filledIndex += cmd->getIndexCount();
 }
 
+V3F_C4B_T2F* Renderer::beginStreamVertices(int vertexCount)
+{
+    _streamBufferIndex = (_streamBufferIndex + 1) % STREAM_BUFFER_COUNT;
+    _streamVerticesMapped = false;
+
+    auto conf = Configuration::getInstance();
+    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    {
+        //Bind VAO
+        GL::bindVAO(_buffersVAO[_streamBufferIndex]);
+        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[_streamBufferIndex][0]);
+
+        // orphaning + glMapBuffer: the driver hands out fresh storage, and the vertices are written straight into it
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * vertexCount, nullptr, GL_DYNAMIC_DRAW);
+        void* buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+        if (buf != nullptr)
+        {
+            _streamVerticesMapped = true;
+            return static_cast<V3F_C4B_T2F*>(buf);
+        }
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[_streamBufferIndex][0]);
+    }
+    return _verts;
+}
+
+void Renderer::endStreamVertices(int vertexCount)
+{
+    auto conf = Configuration::getInstance();
+    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    {
+        if (_streamVerticesMapped)
+        {
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            _streamVerticesMapped = false;
+        }
+        else
+        {
+            // mapping failed, the storage was already orphaned by beginStreamVertices
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(_verts[0]) * vertexCount, _verts);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    else
+    {
+        // Client Side Arrays
+#define kQuadSize sizeof(_verts[0])
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * vertexCount , _verts, GL_DYNAMIC_DRAW);
+
+        GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+
+        // vertices
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
+
+        // colors
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, colors));
+
+        // tex coords
+        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
+#undef kQuadSize
+    }
+}
+
+void Renderer::uploadStreamIndices(int indexCount)
+{
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[_streamBufferIndex][1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * indexCount, _indices, GL_STATIC_DRAW);
+}
+
+void Renderer::unbindStreamBuffers()
+{
+    auto conf = Configuration::getInstance();
+    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    {
+        //Unbind VAO
+        GL::bindVAO(0);
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+}
+
 void Renderer::drawBatchedTriangles()
 {
     if(_queuedTriangleCommands.empty())
@@ -735,11 +916,20 @@ void Renderer::drawBatchedTriangles()
 
     CCGL_DEBUG_INSERT_EVENT_MARKER("RENDERER_BATCH_TRIANGLES");
 
+    int vertexCount = 0;
+    for(const auto& cmd : _queuedTriangleCommands)
+    {
+        vertexCount += (int) cmd->getVertexCount();
+    }
+
     _filledVertex = 0;
     _filledIndex = 0;
 
     /************** 1: Setup up vertices/indices *************/
 
+    // the vertices go straight into the (mapped) vertex buffer when possible
+    V3F_C4B_T2F* vertices = beginStreamVertices(vertexCount);
+
     _triBatchesToDraw[0].offset = 0;
     _triBatchesToDraw[0].indicesToDraw = 0;
     _triBatchesToDraw[0].cmd = nullptr;
@@ -753,7 +943,7 @@ void Renderer::drawBatchedTriangles()
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd);
+        fillVerticesAndIndices(cmd, vertices);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -790,56 +980,8 @@ void Renderer::drawBatchedTriangles()
     batchesTotal++;
 
     /************** 2: Copy vertices/indices to GL objects *************/
-    auto conf = Configuration::getInstance();
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
-    {
-        //Bind VAO
-        GL::bindVAO(_buffersVAO);
-        //Set VBO data
-        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-
-        // option 1: subdata
-//        glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0])*start, sizeof(_quads[0]) * n , &_quads[start] );
-
-        // option 2: data
-//        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _filledVertex, _verts, GL_STATIC_DRAW);
-
-        // option 3: orphaning + glMapBuffer
-        // FIXME: in order to work as fast as possible, it must "and the exact same size and usage hints it had before."
-        //  source: https://www.opengl.org/wiki/Buffer_Object_Streaming#Explicit_multiple_buffering
-        // so most probably we won't have any benefit of using it
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _filledVertex, nullptr, GL_STATIC_DRAW);
-        void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        memcpy(buf, _verts, sizeof(_verts[0]) * _filledVertex);
-        glUnmapBuffer(GL_ARRAY_BUFFER);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
-    }
-    else
-    {
-        // Client Side Arrays
-#define kQuadSize sizeof(_verts[0])
-        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * _filledVertex , _verts, GL_DYNAMIC_DRAW);
-
-        GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
-
-        // vertices
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
-
-        // colors
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, colors));
-
-        // tex coords
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
-    }
+    endStreamVertices(vertexCount);
+    uploadStreamIndices(_filledIndex);
 
     /************** 3: Draw *************/
     for (int i=0; i<batchesTotal; ++i)
@@ -852,22 +994,41 @@ void Renderer::drawBatchedTriangles()
     }
 
     /************** 4: Cleanup *************/
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
-    {
-        //Unbind VAO
-        GL::bindVAO(0);
-    }
-    else
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    }
+    unbindStreamBuffers();
 
     _queuedTriangleCommands.clear();
     _filledVertex = 0;
     _filledIndex = 0;
 }
 
+void Renderer::drawOversizedTriangles(TrianglesCommand* cmd)
+{
+    CCGL_DEBUG_INSERT_EVENT_MARKER("RENDERER_OVERSIZED_TRIANGLES");
+
+    // 16-bit indices cannot address more than VBO_SIZE vertices, so the vertices always fit and only the indices are split
+    const int vertexCount = (int) std::min<ssize_t>(cmd->getVertexCount(), VBO_SIZE);
+    V3F_C4B_T2F* vertices = beginStreamVertices(vertexCount);
+    fillVertices(cmd, vertices, vertexCount);
+    endStreamVertices(vertexCount);
+
+    const unsigned short* indices = cmd->getIndices();
+    const ssize_t indexCount = cmd->getIndexCount();
+    const ssize_t chunkSize = INDEX_VBO_SIZE - INDEX_VBO_SIZE % 3;
+    for (ssize_t offset = 0; offset < indexCount; offset += chunkSize)
+    {
+        const int count = (int) std::min(chunkSize, indexCount - offset);
+        memcpy(_indices, indices + offset, sizeof(_indices[0]) * count);
+        uploadStreamIndices(count);
+
+        cmd->useMaterial();
+        glDrawElements(GL_TRIANGLES, (GLsizei) count, GL_UNSIGNED_SHORT, (GLvoid*) 0);
+        _drawnBatches++;
+        _drawnVertices += count;
+    }
+
+    unbindStreamBuffers();
+}
+
 void Renderer::flush()
 {
     flush2D();
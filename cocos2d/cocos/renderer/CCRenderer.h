@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <stack>
+#include <cstdint>
 
 #include "platform/CCPlatformMacros.h"
 #include "renderer/CCRenderCommand.h"
@@ -95,7 +96,8 @@ public:
     void push_back(RenderCommand* command);
     /**Return the number of render commands.*/
     ssize_t size() const;
-    /**Sort the render commands.*/
+    /**Sort the render commands. GLOBALZ_NEG and GLOBALZ_POS are ordered by globalZ, TRANSPARENT_3D by depth (back to front);
+    ties keep their insertion order.*/
     void sort();
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
@@ -114,8 +116,17 @@ public:
     void restoreRenderState();
     
 protected:
+    /**Stable O(n) sort of a sub queue. Each command gets a packed 64-bit key: the order-preserving bits of its globalZ
+    (or inverted depth when byDepth is true) in the high 32 bits and its insertion index in the low 32 bits. The high half
+    is LSD radix sorted one byte per pass, skipping bytes that are equal for every command.*/
+    void radixSort(std::vector<RenderCommand*>& commands, bool byDepth);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
+    /**Scratch buffers reused by radixSort.*/
+    std::vector<uint64_t> _sortKeys;
+    std::vector<uint64_t> _sortKeysScratch;
+    std::vector<RenderCommand*> _sortedCommands;
     
     /**Cull state.*/
     bool _isCullEnabled;
@@ -145,6 +156,9 @@ public:
     static const int VBO_SIZE = 65536;
     /**The max number of indices in a index buffer.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The number of vertex/index buffer sets the batched triangles rotate through, so a flush does not respecify
+    the buffers that the draws of the previous flushes may still be reading.*/
+    static const int STREAM_BUFFER_COUNT = 3;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
@@ -217,6 +231,18 @@ protected:
     void setupVBO();
     void mapBuffers();
     void drawBatchedTriangles();
+    //Draw a TrianglesCommand with more vertices or indices than one batch holds, splitting its index list
+    void drawOversizedTriangles(TrianglesCommand* cmd);
+
+    //Rotate to the next buffer set, bind it and orphan its vertex buffer. Returns where the vertices must be written:
+    //the mapped buffer when glMapBuffer is usable, otherwise _verts.
+    V3F_C4B_T2F* beginStreamVertices(int vertexCount);
+    //Unmap the vertex buffer, or upload _verts when it could not be mapped
+    void endStreamVertices(int vertexCount);
+    //Upload the first indexCount entries of _indices to the bound buffer set
+    void uploadStreamIndices(int indexCount);
+    //Unbind the buffer set bound by beginStreamVertices
+    void unbindStreamBuffers();
 
     //Draw the previews queued triangles and flush previous context
     void flush();
@@ -230,7 +256,8 @@ protected:
     void processRenderCommand(RenderCommand* command);
     void visitRenderQueue(RenderQueue& queue);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd);
+    void fillVertices(const TrianglesCommand* cmd, V3F_C4B_T2F* vertices, ssize_t vertexCount);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd, V3F_C4B_T2F* vertices);
 
 
     /* clear color set outside be used in setGLDefaultValues() */
@@ -246,8 +273,10 @@ protected:
     //for TrianglesCommand
     V3F_C4B_T2F _verts[VBO_SIZE];
     GLushort _indices[INDEX_VBO_SIZE];
-    GLuint _buffersVAO;
-    GLuint _buffersVBO[2]; //0: vertex  1: indices
+    GLuint _buffersVAO[STREAM_BUFFER_COUNT];
+    GLuint _buffersVBO[STREAM_BUFFER_COUNT][2]; //0: vertex  1: indices
+    int _streamBufferIndex;
+    bool _streamVerticesMapped;
 
     // Internal structure that has the information for the batches
     struct TriBatchToDraw {
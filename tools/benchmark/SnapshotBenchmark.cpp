@@ -0,0 +1,190 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "configs/loaders/LevelConfigLoader.h"
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/GameSnapshot.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @brief GameModel存档方式对比：ValueMap序列化 vs 二进制快照
+ * 每轮对同一局面做一次完整的保存+恢复，输出平均耗时和数据大小
+ * ValueMap路径按旧存档格式序列化撤销记录（每条记录附带两张卡牌的数据）
+ */
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+    
+    double elapsedNanoseconds(Clock::time_point start, int iterations)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    }
+    
+    /**
+     * @brief 模拟一段对局：能消除就消除，否则翻牌，生成撤销记录
+     */
+    void playSomeMoves(GameModel* gameModel, std::vector<UndoRecord>& undoRecords, int moveCount)
+    {
+        for (int i = 0; i < moveCount; ++i)
+        {
+            UndoRecord record = {};
+            record.replacedCardId = gameModel->getBottomCardId();
+            record.playFieldIndex = -1;
+            record.actionType = UndoActionType::REPLACE_BOTTOM_CARD;
+            const std::vector<int>& playFieldCardIds = gameModel->getPlayFieldCardIds();
+            for (size_t j = 0; j < playFieldCardIds.size(); ++j)
+            {
+                if (gameModel->isCardExposed(playFieldCardIds[j])
+                    && gameModel->canCardsMatch(playFieldCardIds[j], record.replacedCardId))
+                {
+                    record.actionType = UndoActionType::ELIMINATE_CARD;
+                    record.cardId = playFieldCardIds[j];
+                    record.playFieldIndex = (int32_t)j;
+                    break;
+                }
+            }
+            if (record.actionType == UndoActionType::REPLACE_BOTTOM_CARD)
+            {
+                if (gameModel->getStackCardIds().empty())
+                {
+                    break;
+                }
+                record.cardId = gameModel->getStackCardIds().back();
+            }
+            
+            if (!UndoManager::applyRecord(gameModel, record))
+            {
+                break;
+            }
+            undoRecords.push_back(record);
+        }
+    }
+    
+    cocos2d::ValueMap saveValueMap(const GameModel* gameModel, const std::vector<UndoRecord>& undoRecords)
+    {
+        cocos2d::ValueMap map = gameModel->toValueMap();
+        cocos2d::ValueVector undoVec;
+        for (const UndoRecord& record : undoRecords)
+        {
+            cocos2d::ValueMap recordMap;
+            recordMap["actionType"] = (int)record.actionType;
+            recordMap["cardId"] = record.cardId;
+            recordMap["replacedCardId"] = record.replacedCardId;
+            recordMap["playFieldIndex"] = record.playFieldIndex;
+            recordMap["cardModel"] = gameModel->getCardById(record.cardId)->toValueMap();
+            recordMap["replacedCardModel"] = gameModel->getCardById(record.replacedCardId)->toValueMap();
+            undoVec.push_back(cocos2d::Value(recordMap));
+        }
+        map["undoRecords"] = undoVec;
+        return map;
+    }
+    
+    void restoreValueMap(const cocos2d::ValueMap& map, GameModel* gameModel, std::vector<UndoRecord>& undoRecords)
+    {
+        gameModel->fromValueMap(map);
+        undoRecords.clear();
+        for (const cocos2d::Value& value : map.at("undoRecords").asValueVector())
+        {
+            const cocos2d::ValueMap& recordMap = value.asValueMap();
+            UndoRecord record = {};
+            record.actionType = (UndoActionType)recordMap.at("actionType").asInt();
+            record.cardId = recordMap.at("cardId").asInt();
+            record.replacedCardId = recordMap.at("replacedCardId").asInt();
+            record.playFieldIndex = recordMap.at("playFieldIndex").asInt();
+            CardModel card;
+            card.fromValueMap(recordMap.at("cardModel").asValueMap());
+            card.fromValueMap(recordMap.at("replacedCardModel").asValueMap());
+            undoRecords.push_back(record);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    int moveCount = argc > 2 ? atoi(argv[2]) : 12;
+    if (iterations <= 0)
+    {
+        iterations = 1;
+    }
+    
+    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(1);
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig);
+    delete levelConfig;
+    if (gameModel == nullptr)
+    {
+        fprintf(stderr, "failed to generate game model\n");
+        return 1;
+    }
+    
+    std::vector<UndoRecord> undoRecords;
+    playSomeMoves(gameModel, undoRecords, moveCount);
+    
+    printf("%d cards, %d undo records, %d iterations\n",
+           gameModel->getCardCount(), (int)undoRecords.size(), iterations);
+    
+    // ValueMap：保存 + 恢复
+    GameModel valueMapModel;
+    std::vector<UndoRecord> valueMapRecords;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        cocos2d::ValueMap map = saveValueMap(gameModel, undoRecords);
+        restoreValueMap(map, &valueMapModel, valueMapRecords);
+    }
+    double valueMapNs = elapsedNanoseconds(start, iterations);
+    
+    // 二进制快照：写入固定缓冲区 + 恢复到已有模型
+    std::vector<unsigned char> buffer(GameSnapshot::getSnapshotSize(gameModel, undoRecords.size()));
+    GameModel snapshotModel;
+    std::vector<UndoRecord> snapshotRecords;
+    size_t snapshotBytes = 0;
+    bool snapshotOk = true;
+    start = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        snapshotBytes = GameSnapshot::write(gameModel, undoRecords.data(), undoRecords.size(), buffer.data(), buffer.size());
+        snapshotOk = GameSnapshot::read(buffer.data(), snapshotBytes, &snapshotModel, &snapshotRecords) && snapshotOk;
+    }
+    double snapshotNs = elapsedNanoseconds(start, iterations);
+    
+    bool sameDeal = snapshotModel.getPlayFieldCardIds() == valueMapModel.getPlayFieldCardIds()
+        && snapshotModel.getStackCardIds() == valueMapModel.getStackCardIds()
+        && snapshotModel.getBottomCardId() == valueMapModel.getBottomCardId()
+        && snapshotRecords.size() == valueMapRecords.size();
+    
+    printf("ValueMap save+restore: %10.0f ns\n", valueMapNs);
+    printf("snapshot save+restore: %10.0f ns (%zu bytes)\n", snapshotNs, snapshotBytes);
+    printf("speedup %.1fx, round trip %s\n", valueMapNs / snapshotNs, (snapshotOk && sameDeal) ? "ok" : "MISMATCH");
+    
+    delete gameModel;
+    return (snapshotOk && sameDeal) ? 0 : 1;
+}
@@ -0,0 +1,575 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "configs/loaders/LevelPack.h"
+#include "configs/loaders/LevelPackFormat.h"
+#include "configs/models/LevelConfig.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 一个关卡的源定义
+ */
+struct LevelDefinition
+{
+    int levelId;
+    std::string name;
+    std::vector<int> playFieldCards;
+    std::vector<int> stackCards;
+    std::vector<std::pair<int, int> > coverCardIds;     // （上层卡牌ID, 被遮挡卡牌ID）
+    std::vector<PlayFieldCoverConfig> covers;           // 校验时换算为主牌区位置
+    PlayFieldLayoutConfig layout;                       // 主牌区布局（未指定时为默认网格）
+    std::string source;     // 文件名:行号，用于报错
+};
+
+static void printUsage(const char* program)
+{
+    printf("Usage: %s -o OUTPUT INPUT...\n", program);
+    printf("Compiles text level definitions into a memory-mappable level pack.\n\n");
+    printf("Input format (one directive per line, '#' starts a comment):\n");
+    printf("  level ID NAME          start a level\n");
+    printf("  playfield ID ID ...    play field card ids (may repeat to append)\n");
+    printf("  stack ID ID ...        stack card ids, bottom to top (may repeat to append)\n");
+    printf("  cover ID ID ...        the first play field card covers the following ones\n");
+    printf("  layout grid COLUMNS DX DY\n");
+    printf("  layout pyramid DX DY   play field layout; DX/DY are the card center spacings\n");
+    printf("  layout custom          play field positions follow in 'position' lines\n");
+    printf("  position X Y ...       card centers relative to the play field center, in play field order\n");
+}
+
+static bool parseFloat(const std::string& token, float& value)
+{
+    char* end = nullptr;
+    value = strtof(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0' && std::isfinite(value);
+}
+
+/**
+ * @brief 解析layout指令的参数
+ */
+static bool parseLayout(std::istringstream& tokens, const std::string& where, PlayFieldLayoutConfig& layout)
+{
+    std::string type;
+    tokens >> type;
+    std::vector<std::string> args;
+    std::string token;
+    while (tokens >> token)
+    {
+        args.push_back(token);
+    }
+    
+    layout = PlayFieldLayoutConfig();
+    if (type == "grid" && args.size() == 3)
+    {
+        char* end = nullptr;
+        long columns = strtol(args[0].c_str(), &end, 10);
+        if (*end != '\0' || columns < 1 || columns > 0xFFFF
+            || !parseFloat(args[1], layout.spacingX) || !parseFloat(args[2], layout.spacingY))
+        {
+            fprintf(stderr, "%s: invalid grid layout\n", where.c_str());
+            return false;
+        }
+        layout.type = PlayFieldLayoutType::GRID;
+        layout.columns = (int)columns;
+        return true;
+    }
+    if (type == "pyramid" && args.size() == 2)
+    {
+        if (!parseFloat(args[0], layout.spacingX) || !parseFloat(args[1], layout.spacingY))
+        {
+            fprintf(stderr, "%s: invalid pyramid layout\n", where.c_str());
+            return false;
+        }
+        layout.type = PlayFieldLayoutType::PYRAMID;
+        return true;
+    }
+    if (type == "custom" && args.empty())
+    {
+        layout.type = PlayFieldLayoutType::CUSTOM;
+        return true;
+    }
+    fprintf(stderr, "%s: expected 'layout grid COLUMNS DX DY', 'layout pyramid DX DY' or 'layout custom'\n", where.c_str());
+    return false;
+}
+
+/**
+ * @brief 读取一个源文件中的所有关卡
+ */
+static bool parseFile(const std::string& filename, std::vector<LevelDefinition>& levels)
+{
+    std::ifstream input(filename.c_str());
+    if (!input)
+    {
+        fprintf(stderr, "%s: cannot open\n", filename.c_str());
+        return false;
+    }
+    
+    std::string line;
+    int lineNumber = 0;
+    LevelDefinition* current = nullptr;
+    while (std::getline(input, line))
+    {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+        
+        std::istringstream tokens(line);
+        std::string directive;
+        if (!(tokens >> directive))
+        {
+            continue;
+        }
+        
+        std::string where = filename + ":" + std::to_string(lineNumber);
+        if (directive == "level")
+        {
+            LevelDefinition level;
+            if (!(tokens >> level.levelId))
+            {
+                fprintf(stderr, "%s: expected level id\n", where.c_str());
+                return false;
+            }
+            std::getline(tokens, level.name);
+            size_t first = level.name.find_first_not_of(" \t\r");
+            size_t last = level.name.find_last_not_of(" \t\r");
+            level.name = (first == std::string::npos) ? std::string() : level.name.substr(first, last - first + 1);
+            level.source = where;
+            levels.push_back(level);
+            current = &levels.back();
+        }
+        else if (directive == "playfield" || directive == "stack" || directive == "cover")
+        {
+            if (current == nullptr)
+            {
+                fprintf(stderr, "%s: '%s' before any 'level'\n", where.c_str(), directive.c_str());
+                return false;
+            }
+            std::vector<int> cards;
+            std::string token;
+            while (tokens >> token)
+            {
+                char* end = nullptr;
+                long cardId = strtol(token.c_str(), &end, 10);
+                if (*end != '\0' || cardId < 0 || cardId > INT32_MAX)
+                {
+                    fprintf(stderr, "%s: invalid card id '%s'\n", where.c_str(), token.c_str());
+                    return false;
+                }
+                cards.push_back((int)cardId);
+            }
+            
+            if (directive == "playfield")
+            {
+                current->playFieldCards.insert(current->playFieldCards.end(), cards.begin(), cards.end());
+            }
+            else if (directive == "stack")
+            {
+                current->stackCards.insert(current->stackCards.end(), cards.begin(), cards.end());
+            }
+            else if (cards.size() < 2)
+            {
+                fprintf(stderr, "%s: 'cover' needs a covering card and at least one covered card\n", where.c_str());
+                return false;
+            }
+            else
+            {
+                for (size_t i = 1; i < cards.size(); ++i)
+                {
+                    current->coverCardIds.push_back(std::make_pair(cards[0], cards[i]));
+                }
+            }
+        }
+        else if (directive == "layout")
+        {
+            if (current == nullptr)
+            {
+                fprintf(stderr, "%s: '%s' before any 'level'\n", where.c_str(), directive.c_str());
+                return false;
+            }
+            if (!parseLayout(tokens, where, current->layout))
+            {
+                return false;
+            }
+        }
+        else if (directive == "position")
+        {
+            if (current == nullptr || current->layout.type != PlayFieldLayoutType::CUSTOM)
+            {
+                fprintf(stderr, "%s: 'position' needs 'layout custom' first\n", where.c_str());
+                return false;
+            }
+            std::vector<float> values;
+            std::string token;
+            while (tokens >> token)
+            {
+                float value = 0.0f;
+                if (!parseFloat(token, value))
+                {
+                    fprintf(stderr, "%s: invalid coordinate '%s'\n", where.c_str(), token.c_str());
+                    return false;
+                }
+                values.push_back(value);
+            }
+            if (values.empty() || values.size() % 2 != 0)
+            {
+                fprintf(stderr, "%s: 'position' needs X Y pairs\n", where.c_str());
+                return false;
+            }
+            for (size_t i = 0; i < values.size(); i += 2)
+            {
+                PlayFieldPositionConfig position = { values[i], values[i + 1] };
+                current->layout.positions.push_back(position);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "%s: unknown directive '%s'\n", where.c_str(), directive.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 把遮挡关系换算为主牌区位置，并检查不成环（否则环上的卡牌永远无法点击）
+ */
+static bool resolveCovers(LevelDefinition& level)
+{
+    std::map<int, int> positions;
+    for (size_t i = 0; i < level.playFieldCards.size(); ++i)
+    {
+        positions[level.playFieldCards[i]] = (int)i;
+    }
+    
+    int playCount = (int)level.playFieldCards.size();
+    std::vector<int> coveringCounts(playCount, 0);
+    std::vector<std::vector<int> > coveredIndices(playCount);
+    level.covers.clear();
+    for (const std::pair<int, int>& cover : level.coverCardIds)
+    {
+        auto coverIt = positions.find(cover.first);
+        auto coveredIt = positions.find(cover.second);
+        if (coverIt == positions.end() || coveredIt == positions.end() || cover.first == cover.second)
+        {
+            fprintf(stderr, "%s: level %d cover %d>%d must join two different play field cards\n",
+                    level.source.c_str(), level.levelId, cover.first, cover.second);
+            return false;
+        }
+        PlayFieldCoverConfig config = { coverIt->second, coveredIt->second };
+        level.covers.push_back(config);
+        ++coveringCounts[config.coveredIndex];
+        coveredIndices[config.coverIndex].push_back(config.coveredIndex);
+    }
+    
+    // Kahn拓扑排序，剩下没有出队的卡牌在环上
+    std::vector<int> exposed;
+    for (int i = 0; i < playCount; ++i)
+    {
+        if (coveringCounts[i] == 0)
+        {
+            exposed.push_back(i);
+        }
+    }
+    int visited = 0;
+    while (!exposed.empty())
+    {
+        int index = exposed.back();
+        exposed.pop_back();
+        ++visited;
+        for (int coveredIndex : coveredIndices[index])
+        {
+            if (--coveringCounts[coveredIndex] == 0)
+            {
+                exposed.push_back(coveredIndex);
+            }
+        }
+    }
+    if (visited != playCount)
+    {
+        fprintf(stderr, "%s: level %d covers form a cycle\n", level.source.c_str(), level.levelId);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 校验关卡：ID唯一、卡牌ID不重复、遮挡关系无环、数量不超过格式上限
+ */
+static bool validateLevels(std::vector<LevelDefinition>& levels)
+{
+    std::sort(levels.begin(), levels.end(), [](const LevelDefinition& a, const LevelDefinition& b) {
+        return a.levelId < b.levelId;
+    });
+    
+    for (size_t i = 0; i < levels.size(); ++i)
+    {
+        LevelDefinition& level = levels[i];
+        if (i > 0 && levels[i - 1].levelId == level.levelId)
+        {
+            fprintf(stderr, "%s: duplicate level %d (first defined at %s)\n",
+                    level.source.c_str(), level.levelId, levels[i - 1].source.c_str());
+            return false;
+        }
+        if (level.name.size() > 0xFFFF || level.playFieldCards.size() > 0xFFFF || level.stackCards.size() > 0xFFFF
+            || level.coverCardIds.size() > 0xFFFF)
+        {
+            fprintf(stderr, "%s: level %d is too large\n", level.source.c_str(), level.levelId);
+            return false;
+        }
+        
+        std::set<int> cardIds;
+        for (const std::vector<int>* cards : { &level.playFieldCards, &level.stackCards })
+        {
+            for (int cardId : *cards)
+            {
+                if (!cardIds.insert(cardId).second)
+                {
+                    fprintf(stderr, "%s: level %d uses card id %d twice\n", level.source.c_str(), level.levelId, cardId);
+                    return false;
+                }
+            }
+        }
+        if (!resolveCovers(level))
+        {
+            return false;
+        }
+        if (level.layout.type == PlayFieldLayoutType::CUSTOM && level.layout.positions.size() != level.playFieldCards.size())
+        {
+            fprintf(stderr, "%s: level %d has %d play field cards but %d positions\n", level.source.c_str(), level.levelId,
+                    (int)level.playFieldCards.size(), (int)level.layout.positions.size());
+            return false;
+        }
+    }
+    
+    if (!levels.empty() && (int64_t)levels.back().levelId - levels.front().levelId >= 0x1000000)
+    {
+        fprintf(stderr, "level ids span more than 16M slots (%d..%d)\n", levels.front().levelId, levels.back().levelId);
+        return false;
+    }
+    return true;
+}
+
+template<typename T>
+static void appendBytes(std::vector<unsigned char>& output, const T* data, size_t count)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    output.insert(output.end(), bytes, bytes + sizeof(T) * count);
+}
+
+/**
+ * @brief 生成关卡包（levels已按ID排序）
+ */
+static std::vector<unsigned char> buildPack(const std::vector<LevelDefinition>& levels)
+{
+    using namespace LevelPackFormat;
+    
+    Header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    header.firstLevelId = levels.empty() ? 0 : levels.front().levelId;
+    header.slotCount = levels.empty() ? 0 : (uint32_t)((int64_t)levels.back().levelId - header.firstLevelId + 1);
+    header.levelCount = (uint32_t)levels.size();
+    header.indexOffset = sizeof(Header);
+    
+    std::vector<IndexEntry> index(header.slotCount);
+    memset(index.data(), 0, index.size() * sizeof(IndexEntry));
+    
+    std::vector<unsigned char> records;
+    uint32_t recordsOffset = header.indexOffset + header.slotCount * (uint32_t)sizeof(IndexEntry);
+    for (const LevelDefinition& level : levels)
+    {
+        Record record;
+        record.levelId = level.levelId;
+        record.nameLength = (uint16_t)level.name.size();
+        record.playFieldCount = (uint16_t)level.playFieldCards.size();
+        record.stackCount = (uint16_t)level.stackCards.size();
+        record.coverCount = (uint16_t)level.covers.size();
+        record.layoutType = (uint16_t)level.layout.type;
+        record.layoutColumns = (uint16_t)level.layout.columns;
+        
+        IndexEntry& entry = index[level.levelId - header.firstLevelId];
+        entry.offset = recordsOffset + (uint32_t)records.size();
+        entry.size = getRecordSize(record.nameLength, record.playFieldCount, record.stackCount, record.coverCount,
+                                   getPositionCount(record));
+        
+        appendBytes(records, &record, 1);
+        appendBytes(records, level.name.data(), level.name.size());
+        records.resize(records.size() + (align4(record.nameLength) - record.nameLength), 0);
+        appendBytes(records, level.playFieldCards.data(), level.playFieldCards.size());
+        appendBytes(records, level.stackCards.data(), level.stackCards.size());
+        for (const PlayFieldCoverConfig& cover : level.covers)
+        {
+            CoverEntry coverEntry = { (uint16_t)cover.coverIndex, (uint16_t)cover.coveredIndex };
+            appendBytes(records, &coverEntry, 1);
+        }
+        LayoutEntry layoutEntry = { level.layout.spacingX, level.layout.spacingY };
+        appendBytes(records, &layoutEntry, 1);
+        for (uint32_t i = 0; i < getPositionCount(record); ++i)
+        {
+            PositionEntry positionEntry = { level.layout.positions[i].x, level.layout.positions[i].y };
+            appendBytes(records, &positionEntry, 1);
+        }
+    }
+    header.fileSize = recordsOffset + (uint32_t)records.size();
+    
+    std::vector<unsigned char> output;
+    output.reserve(header.fileSize);
+    appendBytes(output, &header, 1);
+    appendBytes(output, index.data(), index.size());
+    output.insert(output.end(), records.begin(), records.end());
+    return output;
+}
+
+static bool sameCovers(const std::vector<PlayFieldCoverConfig>& a, const std::vector<PlayFieldCoverConfig>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].coverIndex != b[i].coverIndex || a[i].coveredIndex != b[i].coveredIndex)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameLayout(const PlayFieldLayoutConfig& a, const PlayFieldLayoutConfig& b)
+{
+    if (a.type != b.type || a.columns != b.columns || a.spacingX != b.spacingX || a.spacingY != b.spacingY
+        || a.positions.size() != b.positions.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.positions.size(); ++i)
+    {
+        if (a.positions[i].x != b.positions[i].x || a.positions[i].y != b.positions[i].y)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 用运行时的LevelPack重新读取输出文件，逐关比对
+ */
+static bool verifyPack(const std::string& filename, const std::vector<LevelDefinition>& levels)
+{
+    LevelPack pack;
+    if (!pack.open(filename) || pack.getLevelCount() != (int)levels.size())
+    {
+        fprintf(stderr, "%s: verification failed to open the pack\n", filename.c_str());
+        return false;
+    }
+    
+    for (const LevelDefinition& level : levels)
+    {
+        LevelConfig config;
+        if (!pack.fillLevelConfig(level.levelId, &config) || config.getLevelName() != level.name
+            || config.getPlayFieldCards() != level.playFieldCards || config.getStackCards() != level.stackCards
+            || !sameCovers(config.getPlayFieldCovers(), level.covers) || !sameLayout(config.getPlayFieldLayout(), level.layout))
+        {
+            fprintf(stderr, "%s: verification failed for level %d\n", filename.c_str(), level.levelId);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string outputFile;
+    std::vector<std::string> inputFiles;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            outputFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0 || argv[i][0] == '-')
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            inputFiles.push_back(argv[i]);
+        }
+    }
+    if (outputFile.empty() || inputFiles.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    std::vector<LevelDefinition> levels;
+    for (const std::string& inputFile : inputFiles)
+    {
+        if (!parseFile(inputFile, levels))
+        {
+            return 1;
+        }
+    }
+    if (!validateLevels(levels))
+    {
+        return 1;
+    }
+    
+    std::vector<unsigned char> pack = buildPack(levels);
+    FILE* file = fopen(outputFile.c_str(), "wb");
+    if (file == nullptr || fwrite(pack.data(), 1, pack.size(), file) != pack.size())
+    {
+        fprintf(stderr, "%s: write failed\n", outputFile.c_str());
+        if (file != nullptr)
+        {
+            fclose(file);
+        }
+        return 1;
+    }
+    fclose(file);
+    
+    if (!verifyPack(outputFile, levels))
+    {
+        return 1;
+    }
+    printf("%s: %d levels, %zu bytes\n", outputFile.c_str(), (int)levels.size(), pack.size());
+    return 0;
+}
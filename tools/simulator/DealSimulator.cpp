@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "DealSimulator.h"
+#include "SimulationPolicy.h"
+#include "models/GameModel.h"
+#include "models/CardModel.h"
+
+SimulationStats::SimulationStats()
+: deals(0)
+, wins(0)
+, moves(0)
+, winMoves(0)
+{
+}
+
+void SimulationStats::merge(const SimulationStats& other)
+{
+    deals += other.deals;
+    wins += other.wins;
+    moves += other.moves;
+    winMoves += other.winMoves;
+}
+
+void DealSimulator::collectLegalMoves(const GameModel* gameModel, std::vector<SolverMove>& moves)
+{
+    moves.clear();
+    
+    // 只遍历与底牌相邻点数的桶（桶中只有未被遮挡的卡牌）
+    int bottomFace = gameModel->getCardFace(gameModel->getBottomCardId());
+    if (bottomFace != CFT_NONE)
+    {
+        const int neighborFaces[2] = {
+            (bottomFace + CFT_NUM_CARD_FACE_TYPES - 1) % CFT_NUM_CARD_FACE_TYPES,
+            (bottomFace + 1) % CFT_NUM_CARD_FACE_TYPES
+        };
+        for (int face : neighborFaces)
+        {
+            for (int cardId : gameModel->getPlayFieldCardsByFace((CardFaceType)face))
+            {
+                moves.push_back({ SolverMoveType::PLAY_FIELD_CARD, cardId });
+            }
+        }
+    }
+    
+    const std::vector<int>& stackCardIds = gameModel->getStackCardIds();
+    if (!stackCardIds.empty())
+    {
+        moves.push_back({ SolverMoveType::STACK_CARD, stackCardIds.back() });
+    }
+}
+
+void DealSimulator::applyMove(GameModel* gameModel, const SolverMove& move)
+{
+    if (move.type == SolverMoveType::PLAY_FIELD_CARD)
+    {
+        gameModel->removeFromPlayField(move.cardId);
+    }
+    else
+    {
+        gameModel->removeTopFromStack();
+    }
+    gameModel->setBottomCardId(move.cardId);
+}
+
+bool DealSimulator::playDeal(GameModel* gameModel, SimulationPolicy* policy, SimulationStats& stats)
+{
+    std::vector<SolverMove> legalMoves;
+    uint64_t moveCount = 0;
+    bool won = false;
+    
+    policy->beginDeal(gameModel);
+    while (true)
+    {
+        if (gameModel->getPlayFieldCardIds().empty())
+        {
+            won = true;
+            break;
+        }
+        
+        collectLegalMoves(gameModel, legalMoves);
+        if (legalMoves.empty())
+        {
+            break;
+        }
+        
+        size_t index = policy->chooseMove(gameModel, legalMoves);
+        applyMove(gameModel, legalMoves[index]);
+        ++moveCount;
+    }
+    
+    ++stats.deals;
+    stats.moves += moveCount;
+    if (won)
+    {
+        ++stats.wins;
+        stats.winMoves += moveCount;
+    }
+    return won;
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __DEAL_SIMULATOR_H__
+#define __DEAL_SIMULATOR_H__
+
+#include "services/GameSolver.h"
+#include <cstdint>
+#include <vector>
+
+// 前向声明
+class GameModel;
+class SimulationPolicy;
+
+/**
+ * @brief 模拟统计数据
+ */
+struct SimulationStats
+{
+    uint64_t deals;         // 模拟局数
+    uint64_t wins;          // 获胜局数
+    uint64_t moves;         // 总步数
+    uint64_t winMoves;      // 获胜局的总步数
+    
+    SimulationStats();
+    
+    /**
+     * @brief 合并其他线程的统计
+     */
+    void merge(const SimulationStats& other);
+};
+
+/**
+ * @brief 无界面牌局模拟器
+ * 规则与PlayFieldController/StackController::handleCardClick一致：
+ * 主牌区卡牌与底牌点数差1可消除并成为新底牌；备用牌堆顶部牌可随时翻开替换底牌
+ */
+class DealSimulator
+{
+public:
+    /**
+     * @brief 收集当前所有合法步骤（消除在前，翻牌在后）
+     * @param gameModel 当前牌局
+     * @param moves 输出合法步骤
+     */
+    static void collectLegalMoves(const GameModel* gameModel, std::vector<SolverMove>& moves);
+    
+    /**
+     * @brief 执行一步
+     * @param gameModel 当前牌局
+     * @param move 步骤（须为合法步骤）
+     */
+    static void applyMove(GameModel* gameModel, const SolverMove& move);
+    
+    /**
+     * @brief 用指定策略打完一局
+     * @param gameModel 牌局（会被修改）
+     * @param policy 出牌策略
+     * @param stats 累加统计
+     * @return 是否获胜
+     */
+    static bool playDeal(GameModel* gameModel, SimulationPolicy* policy, SimulationStats& stats);
+
+private:
+    DealSimulator() {}
+    virtual ~DealSimulator() {}
+};
+
+#endif // __DEAL_SIMULATOR_H__
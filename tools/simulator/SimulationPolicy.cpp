@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "SimulationPolicy.h"
+#include "models/GameModel.h"
+#include "models/CardModel.h"
+
+SimulationPolicy* SimulationPolicy::create(const std::string& name, const RandomGenerator& random)
+{
+    if (name == "random")
+    {
+        return new RandomPolicy(random);
+    }
+    if (name == "greedy")
+    {
+        return new GreedyPolicy();
+    }
+    if (name == "solver")
+    {
+        return new SolverPolicy();
+    }
+    return nullptr;
+}
+
+RandomPolicy::RandomPolicy(const RandomGenerator& random)
+: _random(random)
+{
+}
+
+size_t RandomPolicy::chooseMove(const GameModel* /*gameModel*/, const std::vector<SolverMove>& legalMoves)
+{
+    return _random.nextBelow((uint32_t)legalMoves.size());
+}
+
+size_t GreedyPolicy::chooseMove(const GameModel* gameModel, const std::vector<SolverMove>& legalMoves)
+{
+    // 在可消除的牌中，选择消除后主牌区仍有最多可接续匹配的牌
+    size_t bestIndex = legalMoves.size();
+    int bestFollowUps = -1;
+    for (size_t i = 0; i < legalMoves.size(); ++i)
+    {
+        if (legalMoves[i].type != SolverMoveType::PLAY_FIELD_CARD)
+        {
+            continue;
+        }
+        
+        // 相邻点数不包含自身点数，计数中不会含被消除的牌
+        int followUps = gameModel->getPlayFieldMatchCount(legalMoves[i].cardId);
+        if (followUps > bestFollowUps)
+        {
+            bestFollowUps = followUps;
+            bestIndex = i;
+        }
+    }
+    
+    if (bestIndex < legalMoves.size())
+    {
+        return bestIndex;
+    }
+    
+    // 无法消除，翻牌（合法步骤中只剩翻牌）
+    return 0;
+}
+
+SolverPolicy::SolverPolicy()
+: _nextMove(0)
+{
+}
+
+void SolverPolicy::beginDeal(const GameModel* gameModel)
+{
+    SolverResult result = GameSolver::solve(gameModel);
+    _plannedMoves.swap(result.moves);
+    _nextMove = 0;
+}
+
+size_t SolverPolicy::chooseMove(const GameModel* gameModel, const std::vector<SolverMove>& legalMoves)
+{
+    if (_nextMove < _plannedMoves.size())
+    {
+        const SolverMove& planned = _plannedMoves[_nextMove];
+        for (size_t i = 0; i < legalMoves.size(); ++i)
+        {
+            if (legalMoves[i].type == planned.type && legalMoves[i].cardId == planned.cardId)
+            {
+                ++_nextMove;
+                return i;
+            }
+        }
+        // 规划与当前牌局不一致，放弃规划
+        _plannedMoves.clear();
+    }
+    return _fallback.chooseMove(gameModel, legalMoves);
+}
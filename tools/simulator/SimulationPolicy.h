@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __SIMULATION_POLICY_H__
+#define __SIMULATION_POLICY_H__
+
+#include "services/GameSolver.h"
+#include "utils/RandomGenerator.h"
+#include <string>
+#include <vector>
+
+// 前向声明
+class GameModel;
+
+/**
+ * @brief 模拟出牌策略（可插拔）
+ * 每个工作线程持有独立的策略实例，策略内部状态无需加锁
+ */
+class SimulationPolicy
+{
+public:
+    virtual ~SimulationPolicy() {}
+    
+    /**
+     * @brief 根据名称创建策略（random / greedy / solver）
+     * @param name 策略名称
+     * @param random 策略使用的随机数生成器（复制，各线程应传入split()得到的独立生成器）
+     * @return 策略对象，名称无效返回nullptr
+     */
+    static SimulationPolicy* create(const std::string& name, const RandomGenerator& random);
+    
+    /**
+     * @brief 获取策略名称
+     */
+    virtual const char* getName() const = 0;
+    
+    /**
+     * @brief 开始新的一局（可在此预先规划）
+     * @param gameModel 新牌局
+     */
+    virtual void beginDeal(const GameModel* /*gameModel*/) {}
+    
+    /**
+     * @brief 选择下一步
+     * @param gameModel 当前牌局
+     * @param legalMoves 当前所有合法步骤（非空）
+     * @return 选中步骤在legalMoves中的下标
+     */
+    virtual size_t chooseMove(const GameModel* gameModel, const std::vector<SolverMove>& legalMoves) = 0;
+};
+
+/**
+ * @brief 随机策略：在所有合法步骤中均匀随机选择
+ */
+class RandomPolicy : public SimulationPolicy
+{
+public:
+    explicit RandomPolicy(const RandomGenerator& random);
+    virtual const char* getName() const override { return "random"; }
+    virtual size_t chooseMove(const GameModel* gameModel, const std::vector<SolverMove>& legalMoves) override;
+
+private:
+    RandomGenerator _random;    // 随机数生成器
+};
+
+/**
+ * @brief 贪心策略：能消除就消除（优先消除后仍能继续连消的牌），否则翻牌
+ */
+class GreedyPolicy : public SimulationPolicy
+{
+public:
+    virtual const char* getName() const override { return "greedy"; }
+    virtual size_t chooseMove(const GameModel* gameModel, const std::vector<SolverMove>& legalMoves) override;
+};
+
+/**
+ * @brief 最优策略：开局时求解最短获胜步骤并照此出牌，无解时退化为贪心策略
+ */
+class SolverPolicy : public SimulationPolicy
+{
+public:
+    SolverPolicy();
+    virtual const char* getName() const override { return "solver"; }
+    virtual void beginDeal(const GameModel* gameModel) override;
+    virtual size_t chooseMove(const GameModel* gameModel, const std::vector<SolverMove>& legalMoves) override;
+
+private:
+    std::vector<SolverMove> _plannedMoves;  // 求解得到的步骤
+    size_t _nextMove;                       // 下一步在_plannedMoves中的下标
+    GreedyPolicy _fallback;                 // 无解时使用的策略
+};
+
+#endif // __SIMULATION_POLICY_H__
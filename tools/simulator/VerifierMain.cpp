@@ -0,0 +1,308 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "DealSimulator.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "configs/models/LevelConfig.h"
+#include "managers/UndoManager.h"
+#include "models/GameModel.h"
+#include "models/MoveLog.h"
+#include "models/UndoRecord.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "services/MoveLogVerifier.h"
+#include "utils/RandomGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static void printUsage(const char* program)
+{
+    printf("Usage: %s [--pack FILE] LOG...\n", program);
+    printf("       %s [--pack FILE] --bench N [--level N] [--seed N]\n", program);
+    printf("  LOG          move log files written by MoveLog::write\n");
+    printf("  --pack FILE  level pack to load levels from\n");
+    printf("  --bench N    record N random games with undo/redo, round-trip and verify them\n");
+    printf("  --level N    level id for --bench (default 1)\n");
+    printf("  --seed N     random seed for --bench (default 20240101)\n");
+}
+
+static const char* getErrorName(MoveLogVerifyError error)
+{
+    switch (error)
+    {
+        case MoveLogVerifyError::NONE: return "ok";
+        case MoveLogVerifyError::LEVEL_MISMATCH: return "level mismatch";
+        case MoveLogVerifyError::INVALID_DEAL: return "invalid deal";
+        case MoveLogVerifyError::ILLEGAL_TAP: return "illegal play field tap";
+        case MoveLogVerifyError::ILLEGAL_STACK_TAP: return "illegal stack tap";
+        case MoveLogVerifyError::NOTHING_TO_UNDO: return "nothing to undo";
+        case MoveLogVerifyError::NOTHING_TO_REDO: return "nothing to redo";
+        case MoveLogVerifyError::MOVE_AFTER_VICTORY: return "move after victory";
+    }
+    return "unknown";
+}
+
+static bool readFile(const char* filename, std::vector<unsigned char>& data)
+{
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    data.clear();
+    unsigned char chunk[4096];
+    size_t count = 0;
+    while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + count);
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief 校验一个操作记录文件
+ */
+static bool verifyFile(const char* filename)
+{
+    std::vector<unsigned char> data;
+    MoveLog moveLog;
+    if (!readFile(filename, data) || !moveLog.read(data.data(), data.size()))
+    {
+        printf("%s: unreadable move log\n", filename);
+        return false;
+    }
+    
+    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(moveLog.getLevelId());
+    MoveLogVerifyResult result = MoveLogVerifier::verify(moveLog, levelConfig);
+    delete levelConfig;
+    
+    if (!result.valid)
+    {
+        printf("%s: level %d, entry %zu: %s\n", filename, moveLog.getLevelId(),
+               result.failedEntryIndex, getErrorName(result.error));
+        return false;
+    }
+    printf("%s: level %d, %zu entries, %zu moves, %s\n", filename, moveLog.getLevelId(),
+           moveLog.getEntries().size(), result.finalMoveCount, result.won ? "won" : "not won");
+    return true;
+}
+
+/**
+ * @brief 随机打一局并记录操作（约1/8的步骤为回退，回退后约一半再重做）
+ */
+static void recordRandomGame(const LevelConfig* levelConfig, RandomGenerator& random, MoveLog& moveLog)
+{
+    uint64_t dealSeed = random.next();
+    moveLog.reset(levelConfig->getLevelId(), dealSeed);
+    GameModel* gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig, dealSeed);
+    if (gameModel == nullptr)
+    {
+        return;
+    }
+    
+    UndoManager undoManager;
+    undoManager.init(gameModel);
+    std::vector<SolverMove> moves;
+    while (!gameModel->getPlayFieldCardIds().empty())
+    {
+        if (undoManager.canRedo() && random.nextBool(0.5f))
+        {
+            UndoManager::applyRecord(gameModel, *undoManager.getRedoRecord());
+            undoManager.stepForward();
+            moveLog.append(MoveLogAction::REDO);
+            continue;
+        }
+        if (undoManager.canUndo() && random.nextBool(0.125f))
+        {
+            UndoManager::revertRecord(gameModel, *undoManager.getUndoRecord());
+            undoManager.stepBack();
+            moveLog.append(MoveLogAction::UNDO);
+            continue;
+        }
+        
+        DealSimulator::collectLegalMoves(gameModel, moves);
+        if (moves.empty())
+        {
+            break;
+        }
+        const SolverMove& move = moves[random.nextBelow((uint32_t)moves.size())];
+        
+        // 与PlayFieldController/StackController::handleCardClick生成相同的撤销记录
+        UndoRecord record = {};
+        record.cardId = move.cardId;
+        record.replacedCardId = gameModel->getBottomCardId();
+        if (move.type == SolverMoveType::PLAY_FIELD_CARD)
+        {
+            record.actionType = UndoActionType::ELIMINATE_CARD;
+            record.playFieldIndex = gameModel->getPlayFieldIndex(move.cardId);
+            moveLog.append(MoveLogAction::TAP_PLAY_FIELD, move.cardId);
+        }
+        else
+        {
+            record.actionType = UndoActionType::REPLACE_BOTTOM_CARD;
+            record.playFieldIndex = -1;
+            moveLog.append(MoveLogAction::TAP_STACK, move.cardId);
+        }
+        UndoManager::applyRecord(gameModel, record);
+        undoManager.pushUndoRecord(record);
+    }
+    delete gameModel;
+}
+
+/**
+ * @brief 生成随机对局记录，经编码/解码后校验，统计吞吐
+ */
+static bool runBenchmark(int levelId, unsigned long long seed, int count)
+{
+    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(levelId);
+    if (levelConfig == nullptr)
+    {
+        fprintf(stderr, "failed to load level %d\n", levelId);
+        return false;
+    }
+    
+    // 先生成全部记录，计时只包含解码和校验
+    RandomGenerator random(seed);
+    std::vector<std::vector<unsigned char>> encodedLogs(count);
+    size_t totalBytes = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        MoveLog moveLog;
+        recordRandomGame(levelConfig, random, moveLog);
+        encodedLogs[i].resize(moveLog.getEncodedSize());
+        moveLog.write(encodedLogs[i].data(), encodedLogs[i].size());
+        totalBytes += encodedLogs[i].size();
+    }
+    
+    size_t totalEntries = 0;
+    int invalidCount = 0;
+    int wonCount = 0;
+    MoveLog moveLog;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        MoveLogVerifyResult result;
+        if (!moveLog.read(encodedLogs[i].data(), encodedLogs[i].size()))
+        {
+            ++invalidCount;
+            continue;
+        }
+        result = MoveLogVerifier::verify(moveLog, levelConfig);
+        totalEntries += moveLog.getEntries().size();
+        invalidCount += result.valid ? 0 : 1;
+        wonCount += result.won ? 1 : 0;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    delete levelConfig;
+    
+    printf("level %d, %d logs, %zu entries, %.2f bytes/entry\n", levelId, count, totalEntries,
+           totalEntries > 0 ? (double)(totalBytes - count * MoveLog::HEADER_SIZE) / totalEntries : 0.0);
+    printf("invalid %d, won %d, %.3f s, %.0f logs/s, %.0f entries/s\n", invalidCount, wonCount, seconds,
+           seconds > 0 ? count / seconds : 0.0, seconds > 0 ? totalEntries / seconds : 0.0);
+    return invalidCount == 0;
+}
+
+int main(int argc, char** argv)
+{
+    std::string levelPack;
+    std::vector<const char*> files;
+    int benchCount = 0;
+    int levelId = 1;
+    unsigned long long seed = 20240101ULL;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (strncmp(arg, "--", 2) != 0)
+        {
+            files.push_back(arg);
+            continue;
+        }
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        if (strcmp(arg, "--pack") == 0)
+        {
+            levelPack = value;
+        }
+        else if (strcmp(arg, "--bench") == 0)
+        {
+            benchCount = atoi(value);
+        }
+        else if (strcmp(arg, "--level") == 0)
+        {
+            levelId = atoi(value);
+        }
+        else if (strcmp(arg, "--seed") == 0)
+        {
+            seed = strtoull(value, nullptr, 10);
+        }
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg);
+            printUsage(argv[0]);
+            return 1;
+        }
+        ++i;
+    }
+    
+    if (files.empty() && benchCount <= 0)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (!levelPack.empty() && !LevelConfigLoader::openLevelPack(levelPack))
+    {
+        fprintf(stderr, "failed to open level pack %s\n", levelPack.c_str());
+        return 1;
+    }
+    
+    int exitCode = 0;
+    for (const char* filename : files)
+    {
+        if (!verifyFile(filename))
+        {
+            exitCode = 1;
+        }
+    }
+    if (benchCount > 0 && !runBenchmark(levelId, seed, benchCount))
+    {
+        exitCode = 1;
+    }
+    return exitCode;
+}
@@ -0,0 +1,265 @@
+/****************************************************************************
+ Copyright (c) 2017-2018 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "DealSimulator.h"
+#include "SimulationPolicy.h"
+#include "configs/loaders/LevelConfigLoader.h"
+#include "configs/loaders/LevelPackFormat.h"
+#include "models/GameModel.h"
+#include "services/GameModelFromLevelGenerator.h"
+#include "utils/WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 命令行参数
+ */
+struct SimulatorOptions
+{
+    unsigned long long deals;       // 每种策略模拟的局数
+    int threads;                    // 工作线程数（0为硬件并发数）
+    int levelId;                    // 关卡ID
+    std::string levelPack;          // 关卡包文件（为空时使用默认关卡包）
+    unsigned long long seed;        // 牌局和策略的随机种子
+    int chunkSize;                  // 每个任务包含的局数
+    float difficulty;               // 可解牌局的目标难度（小于0表示使用随机牌局）
+    std::vector<std::string> policies;  // 策略列表
+    
+    SimulatorOptions()
+    : deals(1000000)
+    , threads(0)
+    , levelId(1)
+    , seed(20240101ULL)
+    , chunkSize(1024)
+    , difficulty(-1.0f)
+    {
+    }
+};
+
+static void printUsage(const char* program)
+{
+    printf("Usage: %s [options]\n", program);
+    printf("  --deals N      deals per policy (default 1000000)\n");
+    printf("  --threads N    worker threads, 0 = hardware concurrency (default 0)\n");
+    printf("  --policy NAME  random | greedy | solver | all (default all)\n");
+    printf("  --level N      level id passed to LevelConfigLoader (default 1)\n");
+    printf("  --pack FILE    level pack to load levels from (default %s)\n", LevelPackFormat::DEFAULT_FILE);
+    printf("  --seed N       deal and policy random seed (default 20240101)\n");
+    printf("  --chunk N      deals per work item (default 1024)\n");
+    printf("  --solvable D   deal solvable-by-construction games of difficulty D (0..1) seeded from --seed\n");
+}
+
+static bool parseOptions(int argc, char** argv, SimulatorOptions& options)
+{
+    std::string policy = "all";
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            return false;
+        }
+        if (value == nullptr)
+        {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        
+        if (strcmp(arg, "--deals") == 0)
+        {
+            options.deals = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--threads") == 0)
+        {
+            options.threads = atoi(value);
+        }
+        else if (strcmp(arg, "--policy") == 0)
+        {
+            policy = value;
+        }
+        else if (strcmp(arg, "--level") == 0)
+        {
+            options.levelId = atoi(value);
+        }
+        else if (strcmp(arg, "--pack") == 0)
+        {
+            options.levelPack = value;
+        }
+        else if (strcmp(arg, "--seed") == 0)
+        {
+            options.seed = strtoull(value, nullptr, 10);
+        }
+        else if (strcmp(arg, "--chunk") == 0)
+        {
+            options.chunkSize = std::max(1, atoi(value));
+        }
+        else if (strcmp(arg, "--solvable") == 0)
+        {
+            options.difficulty = (float)atof(value);
+        }
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return false;
+        }
+        ++i;
+    }
+    
+    if (policy == "all")
+    {
+        options.policies = { "random", "greedy", "solver" };
+    }
+    else
+    {
+        options.policies = { policy };
+    }
+    return true;
+}
+
+/**
+ * @brief 用一种策略模拟全部牌局并输出统计
+ */
+static bool runPolicy(const std::string& policyName, const SimulatorOptions& options,
+                      const LevelConfig* levelConfig, WorkStealingPool& pool)
+{
+    int threadCount = pool.getThreadCount();
+    std::vector<std::unique_ptr<SimulationPolicy>> policies;
+    // 每个工作线程拆分出互不重叠的随机序列
+    RandomGenerator policyRandom(options.seed);
+    for (int i = 0; i < threadCount; ++i)
+    {
+        SimulationPolicy* policy = SimulationPolicy::create(policyName, policyRandom.split());
+        if (policy == nullptr)
+        {
+            fprintf(stderr, "unknown policy %s\n", policyName.c_str());
+            return false;
+        }
+        policies.push_back(std::unique_ptr<SimulationPolicy>(policy));
+    }
+    
+    std::vector<SimulationStats> workerStats(threadCount);
+    
+    auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long long begin = 0; begin < options.deals; begin += options.chunkSize)
+    {
+        unsigned long long count = std::min<unsigned long long>(options.chunkSize, options.deals - begin);
+        pool.submit([&, begin, count](int workerIndex) {
+            SimulationPolicy* policy = policies[workerIndex].get();
+            SimulationStats& stats = workerStats[workerIndex];
+            for (unsigned long long i = 0; i < count; ++i)
+            {
+                // 每局种子由局下标推导，牌局与线程数和调度顺序无关，生成时无需加锁
+                uint64_t dealSeed = GameModelFromLevelGenerator::getBatchDealSeed(options.seed, (int)(begin + i));
+                GameModel* gameModel = nullptr;
+                if (options.difficulty >= 0.0f)
+                {
+                    gameModel = GameModelFromLevelGenerator::generateSolvableGameModel(levelConfig, dealSeed, options.difficulty);
+                }
+                else
+                {
+                    gameModel = GameModelFromLevelGenerator::generateGameModel(levelConfig, dealSeed);
+                }
+                if (gameModel == nullptr)
+                {
+                    continue;
+                }
+                DealSimulator::playDeal(gameModel, policy, stats);
+                delete gameModel;
+            }
+        });
+    }
+    pool.waitAll();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    
+    SimulationStats total;
+    for (const SimulationStats& stats : workerStats)
+    {
+        total.merge(stats);
+    }
+    
+    double winRate = total.deals > 0 ? 100.0 * total.wins / total.deals : 0.0;
+    double meanMoves = total.deals > 0 ? (double)total.moves / total.deals : 0.0;
+    double meanWinMoves = total.wins > 0 ? (double)total.winMoves / total.wins : 0.0;
+    double dealsPerSecond = seconds > 0 ? total.deals / seconds : 0.0;
+    double movesPerSecond = seconds > 0 ? total.moves / seconds : 0.0;
+    printf("%-8s %12llu %9.3f%% %11.2f %11.2f %14.0f %14.0f %9.3f\n",
+           policyName.c_str(), (unsigned long long)total.deals, winRate, meanMoves, meanWinMoves,
+           dealsPerSecond, movesPerSecond, seconds);
+    fflush(stdout);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    SimulatorOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    if (!options.levelPack.empty() && !LevelConfigLoader::openLevelPack(options.levelPack))
+    {
+        fprintf(stderr, "failed to open level pack %s\n", options.levelPack.c_str());
+        return 1;
+    }
+    
+    LevelConfig* levelConfig = LevelConfigLoader::loadLevelConfig(options.levelId);
+    if (levelConfig == nullptr)
+    {
+        fprintf(stderr, "failed to load level %d\n", options.levelId);
+        return 1;
+    }
+    
+    WorkStealingPool pool(options.threads);
+    printf("level %d, %llu deals per policy, %d threads\n",
+           options.levelId, options.deals, pool.getThreadCount());
+    if (options.difficulty >= 0.0f)
+    {
+        printf("solvable deals, difficulty %.2f, seed %llu\n", options.difficulty, options.seed);
+    }
+    printf("%-8s %12s %10s %11s %11s %14s %14s %9s\n",
+           "policy", "deals", "win rate", "mean moves", "win moves", "deals/s", "moves/s", "seconds");
+    
+    int exitCode = 0;
+    for (const std::string& policyName : options.policies)
+    {
+        if (!runPolicy(policyName, options, levelConfig, pool))
+        {
+            exitCode = 1;
+            break;
+        }
+    }
+    
+    delete levelConfig;
+    return exitCode;
+}